@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cliq::bench {
+/// \brief Total heap allocations made by the process so far.
+[[nodiscard]] auto get_allocation_count() -> std::uint64_t;
+
+/// \brief Per-run state passed to a benchmark body.
+/// Setup done before the first call to keep_running() is not measured.
+class State {
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit State(std::int64_t const iterations) : m_iterations(iterations), m_remaining(iterations) {}
+
+	[[nodiscard]] auto keep_running() -> bool {
+		if (m_remaining == m_iterations) {
+			m_allocations = get_allocation_count();
+			m_start = Clock::now();
+		}
+		if (m_remaining-- > 0) { return true; }
+		m_elapsed = Clock::now() - m_start;
+		m_allocations = get_allocation_count() - m_allocations;
+		return false;
+	}
+
+	[[nodiscard]] auto get_iterations() const -> std::int64_t { return m_iterations; }
+	[[nodiscard]] auto get_elapsed() const -> Clock::duration { return m_elapsed; }
+	[[nodiscard]] auto get_allocations() const -> std::uint64_t { return m_allocations; }
+
+	/// \brief Items (eg tokens) processed per iteration, used to report ns/item.
+	std::int64_t items_per_iteration{1};
+
+  private:
+	std::int64_t m_iterations{};
+	std::int64_t m_remaining{};
+	Clock::time_point m_start{};
+	Clock::duration m_elapsed{};
+	std::uint64_t m_allocations{};
+};
+
+using Func = std::function<void(State&)>;
+
+struct Benchmark {
+	std::string name{};
+	Func func{};
+};
+
+[[nodiscard]] auto get_registry() -> std::vector<Benchmark>&;
+
+/// \brief Register a benchmark at static initialization time.
+struct Register {
+	Register(std::string name, Func func) { get_registry().push_back(Benchmark{.name = std::move(name), .func = std::move(func)}); }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+inline void const* volatile g_sink{};
+
+/// \brief Defeat dead-store elimination of a result.
+template <typename Type>
+void keep(Type const& t) {
+	g_sink = &t;
+}
+
+/// \brief Argument counts exercised by scaling benchmarks.
+inline constexpr auto argv_sizes_v = std::array<std::int64_t, 5>{10, 100, 1'000, 10'000, 100'000};
+/// \brief Option counts exercised by scaling benchmarks.
+inline constexpr auto arg_set_sizes_v = std::array<std::int64_t, 3>{5, 50, 1'000};
+} // namespace cliq::bench
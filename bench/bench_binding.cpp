@@ -0,0 +1,123 @@
+#include <bench.hpp>
+#include <cliq/arg.hpp>
+#include <parser.hpp>
+#include <threaded_batch.hpp>
+#include <algorithm>
+#include <format>
+#include <thread>
+
+namespace cliq::bench {
+namespace {
+constexpr auto app_info_v = AppInfo{};
+
+/// \brief Generated numeric values: integers, or floats with a fractional part.
+template <NumberT Type>
+struct Numbers {
+	explicit Numbers(std::int64_t const count) {
+		storage.reserve(std::size_t(count));
+		for (auto i = std::int64_t{}; i < count; ++i) {
+			if constexpr (std::floating_point<Type>) {
+				storage.push_back(std::format("{}.{:03}", (i * 7919) % 100'000, i % 1000));
+			} else {
+				storage.push_back(std::format("{}", (i * 7919) % 10'000'000 - 5'000'000));
+			}
+		}
+		pointers.reserve(storage.size());
+		for (auto const& str : storage) { pointers.push_back(str.c_str()); }
+	}
+
+	std::vector<std::string> storage{};
+	std::vector<char const*> pointers{};
+};
+
+template <NumberT Type>
+void run_per_token(State& state, std::int64_t const count) {
+	auto const numbers = Numbers<Type>{count};
+	auto out = std::vector<Type>{};
+	auto const binding = Binding::create<std::vector<Type>>();
+	state.items_per_iteration = count;
+	while (state.keep_running()) {
+		out.clear();
+		for (auto const* value : numbers.pointers) { keep(binding.assign(&out, value)); }
+	}
+}
+
+template <NumberT Type>
+void run_batch(State& state, std::int64_t const count) {
+	auto const numbers = Numbers<Type>{count};
+	auto out = std::vector<Type>{};
+	auto const binding = Binding::create<std::vector<Type>>();
+	state.items_per_iteration = count;
+	while (state.keep_running()) {
+		out.clear();
+		keep(binding.assign_batch(&out, numbers.pointers, nullptr));
+	}
+}
+
+template <NumberT Type>
+void run_threaded(State& state, std::int64_t const count) {
+	auto const numbers = Numbers<Type>{count};
+	auto out = std::vector<Type>{};
+	auto const binding = Binding::create<std::vector<Type>>();
+	auto const executor = ThreadedBatch{std::max(std::thread::hardware_concurrency(), 1u)};
+	state.items_per_iteration = count;
+	while (state.keep_running()) {
+		out.clear();
+		keep(binding.assign_batch(&out, numbers.pointers, &executor));
+	}
+}
+
+/// \brief Cost of assigning one option value, through the function pointer or the tag switch.
+template <NumberT Type, bool Dispatch>
+void run_assign(State& state) {
+	auto const numbers = Numbers<Type>{1'000};
+	auto out = Type{};
+	auto binding = Binding::create<Type>();
+	keep(binding);
+	state.items_per_iteration = std::int64_t(numbers.pointers.size());
+	while (state.keep_running()) {
+		for (auto const* value : numbers.pointers) {
+			if constexpr (Dispatch) {
+				keep(binding.dispatch_assign(&out, value));
+			} else {
+				keep(binding.assign(&out, value));
+			}
+		}
+	}
+}
+
+template <NumberT Type>
+void run_parser(State& state, std::int64_t const count) {
+	auto const numbers = Numbers<Type>{count};
+	auto out = std::vector<Type>{};
+	auto const args = std::array{list(out, "values")};
+	state.items_per_iteration = count;
+	while (state.keep_running()) {
+		out = std::vector<Type>{};
+		auto parser = Parser{app_info_v, "bench", numbers.pointers};
+		keep(parser.parse(args));
+	}
+}
+
+template <NumberT Type>
+void register_type(std::string_view const type_name) {
+	Register{std::format("assign/indirect/{}", type_name), [](State& state) { run_assign<Type, false>(state); }};
+	Register{std::format("assign/dispatch/{}", type_name), [](State& state) { run_assign<Type, true>(state); }};
+	for (auto const size : argv_sizes_v) {
+		Register{std::format("assign_list/per_token/{}/values:{}", type_name, size), [size](State& state) { run_per_token<Type>(state, size); }};
+		Register{std::format("assign_list/batch/{}/values:{}", type_name, size), [size](State& state) { run_batch<Type>(state, size); }};
+		Register{std::format("assign_list/threaded/{}/values:{}", type_name, size), [size](State& state) { run_threaded<Type>(state, size); }};
+		Register{std::format("parser_list/{}/argv:{}", type_name, size), [size](State& state) { run_parser<Type>(state, size); }};
+	}
+}
+
+auto register_all() -> bool {
+	register_type<int>("int");
+	register_type<std::int64_t>("int64");
+	register_type<double>("double");
+	return true;
+}
+
+auto const all_v = register_all();
+} // namespace
+} // namespace cliq::bench
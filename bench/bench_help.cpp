@@ -0,0 +1,28 @@
+#include <bench.hpp>
+#include <fixture.hpp>
+#include <help.hpp>
+
+namespace cliq::bench {
+namespace {
+constexpr auto app_info_v = AppInfo{.help_text = "benchmark app", .epilogue = "epilogue"};
+
+auto register_help() -> bool {
+	for (auto const arg_count : arg_set_sizes_v) {
+		Register{std::format("format_help/args:{}", arg_count), [arg_count](State& state) {
+					 auto const options = OptionSet{arg_count};
+					 auto const lookup = Lookup{options.args};
+					 state.items_per_iteration = arg_count;
+					 while (state.keep_running()) { keep(format_help(app_info_v, "bench", {}, lookup)); }
+				 }};
+		Register{std::format("format_usage/args:{}", arg_count), [arg_count](State& state) {
+					 auto const options = OptionSet{arg_count};
+					 state.items_per_iteration = arg_count;
+					 while (state.keep_running()) { keep(format_usage("bench", {}, options.args)); }
+				 }};
+	}
+	return true;
+}
+
+auto const help_v = register_help();
+} // namespace
+} // namespace cliq::bench
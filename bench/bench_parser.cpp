@@ -0,0 +1,137 @@
+#include <bench.hpp>
+#include <cliq/compiled_parser.hpp>
+#include <fixture.hpp>
+#include <lookup.hpp>
+#include <parser.hpp>
+#include <filesystem>
+#include <fstream>
+
+namespace cliq::bench {
+namespace {
+constexpr auto app_info_v = AppInfo{};
+
+auto register_options() -> bool {
+	for (auto const arg_count : arg_set_sizes_v) {
+		for (auto const size : argv_sizes_v) {
+			Register{std::format("parser_options/args:{}/argv:{}", arg_count, size), [arg_count, size](State& state) {
+						 auto const options = OptionSet{arg_count};
+						 auto const argv = Argv{size, options.get_word_count()};
+						 state.items_per_iteration = size;
+						 while (state.keep_running()) {
+							 auto parser = Parser{app_info_v, "bench", argv.get_args()};
+							 keep(parser.parse(options.args));
+						 }
+					 }};
+		}
+	}
+	return true;
+}
+
+auto register_compiled() -> bool {
+	for (auto const arg_count : arg_set_sizes_v) {
+		Register{std::format("compiled_parser/args:{}/argv:10", arg_count), [arg_count](State& state) {
+					 auto const options = OptionSet{arg_count};
+					 auto const argv = Argv{10, options.get_word_count()};
+					 auto parser = CompiledParser{app_info_v, options.args, "bench"};
+					 state.items_per_iteration = 10;
+					 while (state.keep_running()) { keep(parser.parse(argv.get_args())); }
+				 }};
+	}
+	return true;
+}
+
+auto register_commands() -> bool {
+	for (auto const cmd_count : arg_set_sizes_v) {
+		Register{std::format("parser_command/commands:{}/argv:1000", cmd_count), [cmd_count](State& state) {
+					 auto const options = OptionSet{50};
+					 auto names = std::vector<std::string>{};
+					 names.reserve(std::size_t(cmd_count));
+					 auto args = std::vector<Arg>{};
+					 args.reserve(std::size_t(cmd_count));
+					 for (auto i = std::int64_t{}; i < cmd_count; ++i) {
+						 names.push_back(std::format("cmd-{}", i));
+						 args.emplace_back(options.args, names.back());
+					 }
+					 auto argv = Argv{999, options.get_word_count()};
+					 argv.pointers.insert(argv.pointers.begin(), names.back().c_str());
+					 state.items_per_iteration = std::int64_t(argv.pointers.size());
+					 while (state.keep_running()) {
+						 auto parser = Parser{app_info_v, "bench", argv.get_args()};
+						 keep(parser.parse(args));
+					 }
+				 }};
+	}
+	return true;
+}
+
+auto const options_v = register_options();
+template <typename Type>
+void run_list(State& state, std::int64_t const size) {
+	auto storage = std::vector<std::string>{};
+	auto argv = std::vector<char const*>{};
+	for (auto i = std::int64_t{}; i < size; ++i) { storage.push_back(std::format("/data/inputs/shard-{:06}/part.bin", i)); }
+	for (auto const& str : storage) { argv.push_back(str.c_str()); }
+	auto inputs = Type{};
+	auto const args = std::array{list(inputs, "inputs")};
+	state.items_per_iteration = size;
+	while (state.keep_running()) {
+		inputs = Type{};
+		auto parser = Parser{app_info_v, "bench", argv};
+		keep(parser.parse(args));
+	}
+}
+
+auto register_list() -> bool {
+	for (auto const size : argv_sizes_v) {
+		Register{std::format("parser_list/vector/argv:{}", size), [size](State& state) { run_list<std::vector<std::string_view>>(state, size); }};
+		Register{std::format("parser_list/argv_span/argv:{}", size), [size](State& state) { run_list<ArgvSpan>(state, size); }};
+	}
+	return true;
+}
+
+auto register_response_file() -> bool {
+	for (auto const size : argv_sizes_v) {
+		Register{std::format("response_file/paths:{}", size), [size](State& state) {
+					 auto const path = std::filesystem::temp_directory_path() / std::format("cliq_bench_{}.rsp", size);
+					 {
+						 auto file = std::ofstream{path};
+						 for (auto i = std::int64_t{}; i < size; ++i) { file << std::format("/data/inputs/shard-{:06}/part.bin\n", i); }
+					 }
+					 auto const arg = "@" + path.string();
+					 auto const argv = std::array{arg.c_str()};
+					 auto const config = ParseConfig{.response_files = true};
+					 auto inputs = std::vector<std::string_view>{};
+					 auto const args = std::array{list(inputs, "inputs")};
+					 state.items_per_iteration = size;
+					 while (state.keep_running()) {
+						 inputs.clear();
+						 auto parser = Parser{app_info_v, "bench", argv, config};
+						 keep(parser.parse(args));
+					 }
+					 std::filesystem::remove(path);
+				 }};
+	}
+	return true;
+}
+
+auto register_suggest() -> bool {
+	for (auto const arg_count : arg_set_sizes_v) {
+		// error path only: a linear scan over every option word, most rejected by length alone.
+		Register{std::format("lookup_suggest/args:{}", arg_count), [arg_count](State& state) {
+					 auto const options = OptionSet{arg_count};
+					 auto const lookup = Lookup{options.args};
+					 auto const typo = std::format("otp-{}", options.get_word_count() - 1);
+					 state.items_per_iteration = std::int64_t(options.args.size());
+					 while (state.keep_running()) { keep(lookup.suggest_option(typo)); }
+				 }};
+	}
+	return true;
+}
+
+auto const compiled_v = register_compiled();
+auto const list_v = register_list();
+auto const response_file_v = register_response_file();
+auto const commands_v = register_commands();
+auto const suggest_v = register_suggest();
+} // namespace
+} // namespace cliq::bench
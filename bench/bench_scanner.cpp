@@ -0,0 +1,51 @@
+#include <bench.hpp>
+#include <fixture.hpp>
+#include <scanner.hpp>
+#include <algorithm>
+
+namespace cliq::bench {
+namespace {
+auto const to_token_v = Register{"to_token", [](State& state) {
+									 static constexpr auto inputs_v = std::array<std::string_view, 8>{
+										 "--", "foo", "-abc", "-abc=42", "--word", "--word=value", "-5", "/path/to/file.txt",
+									 };
+									 state.items_per_iteration = std::int64_t(inputs_v.size());
+									 while (state.keep_running()) {
+										 for (auto const input : inputs_v) { keep(to_token(input)); }
+									 }
+								 }};
+
+auto register_scanner() -> bool {
+	for (auto const size : argv_sizes_v) {
+		Register{std::format("scanner_next/argv:{}", size), [size](State& state) {
+					 auto const argv = Argv{size, 16};
+					 state.items_per_iteration = size;
+					 while (state.keep_running()) {
+						 auto scanner = Scanner{argv.get_args()};
+						 while (scanner.next()) {
+							 for (auto letter = char{}; scanner.next_letter(letter);) { keep(letter); }
+							 keep(scanner.get_value());
+						 }
+					 }
+				 }};
+	}
+	for (auto const size : argv_sizes_v) {
+		Register{std::format("scanner_line/words:{}", size), [size](State& state) {
+					 auto const argv = Argv{size, 16};
+					 auto line = std::string{};
+					 for (auto const& arg : argv.storage) { std::format_to(std::back_inserter(line), "'{}' ", arg); }
+					 auto buffer = line;
+					 state.items_per_iteration = size;
+					 while (state.keep_running()) {
+						 std::ranges::copy(line, buffer.begin()); // tokenizing compacts quoted words in place
+						 auto scanner = Scanner{Tokenizer{buffer}};
+						 while (scanner.next()) { keep(scanner.get_value()); }
+					 }
+				 }};
+	}
+	return true;
+}
+
+auto const scanner_v = register_scanner();
+} // namespace
+} // namespace cliq::bench
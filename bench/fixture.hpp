@@ -0,0 +1,63 @@
+#pragma once
+#include <cliq/arg.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace cliq::bench {
+/// \brief Generated set of options: two letter flags (-v, -q) followed by integer options (--opt-N).
+struct OptionSet {
+	explicit OptionSet(std::int64_t const count) {
+		auto const ints = std::max(count - 2, std::int64_t{1});
+		keys.reserve(std::size_t(ints));
+		values.resize(std::size_t(ints));
+		args.reserve(std::size_t(ints) + 2);
+		args.emplace_back(verbose, "v,verbose", "verbose flag");
+		args.emplace_back(quiet, "q,quiet", "quiet flag");
+		for (auto i = std::int64_t{}; i < ints; ++i) {
+			keys.push_back(std::format("opt-{}", i));
+			args.emplace_back(values[std::size_t(i)], keys.back(), "integer option");
+		}
+	}
+
+	[[nodiscard]] auto get_word_count() const -> std::size_t { return keys.size(); }
+
+	bool verbose{};
+	bool quiet{};
+	std::vector<std::string> keys{};
+	std::vector<int> values{};
+	std::vector<Arg> args{};
+};
+
+/// \brief Generated argument vector (excluding argv[0]) using only the first word_count words of an OptionSet.
+struct Argv {
+	explicit Argv(std::int64_t const token_count, std::size_t const word_count) {
+		storage.reserve(std::size_t(token_count));
+		for (auto i = std::size_t{}; std::int64_t(storage.size()) < token_count; ++i) {
+			auto const remain = token_count - std::int64_t(storage.size());
+			auto const word = std::format("--opt-{}", i % word_count);
+			switch (i % 3) {
+			case 0: storage.push_back(std::format("{}={}", word, i)); break;
+			case 1:
+				if (remain < 2) {
+					storage.emplace_back("-v");
+					break;
+				}
+				storage.push_back(word);
+				storage.push_back(std::to_string(i));
+				break;
+			default: storage.emplace_back("-vq"); break;
+			}
+		}
+		pointers.reserve(storage.size());
+		for (auto const& str : storage) { pointers.push_back(str.c_str()); }
+	}
+
+	[[nodiscard]] auto get_args() const -> std::span<char const* const> { return pointers; }
+
+	std::vector<std::string> storage{};
+	std::vector<char const*> pointers{};
+};
+} // namespace cliq::bench
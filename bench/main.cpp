@@ -0,0 +1,127 @@
+#include <cliq/parse.hpp>
+#include <bench.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+#include <print>
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::uint64_t> g_allocations{};
+
+// std::aligned_alloc is not provided by MSVC, and its blocks must be released with _aligned_free.
+auto aligned_allocate(std::size_t const size, std::size_t const alignment) -> void* {
+#if defined(_WIN32)
+	return _aligned_malloc(size, alignment);
+#else
+	// size must be a multiple of alignment.
+	return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment); // NOLINT(cppcoreguidelines-no-malloc)
+#endif
+}
+
+void aligned_free(void* ptr) {
+#if defined(_WIN32)
+	_aligned_free(ptr);
+#else
+	std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+#endif
+}
+} // namespace
+
+// count every heap allocation so benchmarks can report allocs/op.
+auto operator new(std::size_t const size) -> void* {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ret = std::malloc(size == 0 ? 1 : size)) { return ret; } // NOLINT(cppcoreguidelines-no-malloc)
+	throw std::bad_alloc{};
+}
+
+auto operator new(std::size_t const size, std::align_val_t const align) -> void* {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ret = aligned_allocate(std::max(size, std::size_t{1}), std::max(std::size_t(align), sizeof(void*)))) { return ret; }
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); } // NOLINT(cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); } // NOLINT(cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::align_val_t /*align*/) noexcept { aligned_free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/, std::align_val_t /*align*/) noexcept { aligned_free(ptr); }
+
+auto cliq::bench::get_allocation_count() -> std::uint64_t { return g_allocations.load(std::memory_order_relaxed); }
+
+auto cliq::bench::get_registry() -> std::vector<Benchmark>& {
+	static auto ret = std::vector<Benchmark>{};
+	return ret;
+}
+
+namespace {
+using Clock = cliq::bench::State::Clock;
+
+auto measure(cliq::bench::Func const& func, std::int64_t const iterations) -> cliq::bench::State {
+	auto ret = cliq::bench::State{iterations};
+	func(ret);
+	return ret;
+}
+
+auto run(cliq::bench::Benchmark const& benchmark, Clock::duration const min_time) -> cliq::bench::State {
+	auto iterations = std::int64_t{1};
+	auto ret = measure(benchmark.func, iterations);
+	while (ret.get_elapsed() < min_time && iterations < 1'000'000'000) {
+		auto const elapsed_ns = std::max(std::chrono::duration<double, std::nano>(ret.get_elapsed()).count(), 1.0);
+		auto const target_ns = std::chrono::duration<double, std::nano>(min_time).count() * 1.2;
+		iterations = std::clamp(std::int64_t(double(iterations) * target_ns / elapsed_ns), iterations + 1, iterations * 10);
+		ret = measure(benchmark.func, iterations);
+	}
+	return ret;
+}
+
+void report(std::string_view const name, cliq::bench::State const& state) {
+	auto const ns = std::chrono::duration<double, std::nano>(state.get_elapsed()).count();
+	auto const ns_per_op = ns / double(state.get_iterations());
+	auto const ns_per_item = ns_per_op / double(std::max(state.items_per_iteration, std::int64_t{1}));
+	auto const allocs_per_op = double(state.get_allocations()) / double(state.get_iterations());
+	std::println("{:<52} {:>14.1f} {:>10.2f} {:>10.1f} {:>12}", name, ns_per_op, ns_per_item, allocs_per_op, state.get_iterations());
+}
+
+auto run(int argc, char const* const* argv) -> int {
+	static constexpr auto app_info_v = cliq::AppInfo{
+		.help_text = "run cliq micro-benchmarks",
+		.version = cliq::version_v,
+	};
+
+	auto filter = std::string_view{};
+	auto min_time_ms = 100;
+	auto const args = std::array{
+		cliq::option(filter, "f,filter", "run only benchmarks whose name contains this"),
+		cliq::option(min_time_ms, "t,min-time", "minimum measured time per benchmark (ms)"),
+	};
+	auto const parse_result = cliq::parse(app_info_v, args, argc, argv);
+	if (parse_result.early_return()) { return parse_result.get_return_code(); }
+
+	auto const min_time = std::chrono::milliseconds{min_time_ms};
+	std::println("{:<52} {:>14} {:>10} {:>10} {:>12}", "Benchmark", "ns/op", "ns/item", "allocs/op", "Iterations");
+	std::println("{}", std::string(102, '-'));
+	for (auto const& benchmark : cliq::bench::get_registry()) {
+		if (!filter.empty() && !benchmark.name.contains(filter)) { continue; }
+		report(benchmark.name, run(benchmark, min_time));
+	}
+
+	return EXIT_SUCCESS;
+}
+} // namespace
+
+auto main(int argc, char** argv) -> int {
+	try {
+		return run(argc, argv);
+	} catch (std::exception const& e) {
+		std::println(stderr, "PANIC: {}", e.what());
+		return EXIT_FAILURE;
+	} catch (...) {
+		std::println(stderr, "FATAL ERROR");
+		return EXIT_FAILURE;
+	}
+}
@@ -0,0 +1,129 @@
+#include <cliq/parse.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cliq::fuzz {
+namespace {
+constexpr auto app_info_v = AppInfo{.help_text = "fuzz", .version = "0"};
+constexpr auto words_v = std::array<std::string_view, 8>{"alpha", "all", "beta", "count", "co", "name", "x-y", "verbose"};
+constexpr std::size_t max_args_v{8};
+
+/// \brief Consumes fuzz input front to back; reads past the end as zeros.
+class Input {
+  public:
+	explicit Input(std::span<std::uint8_t const> data) : m_data(data) {}
+
+	auto byte() -> std::uint8_t {
+		if (m_data.empty()) { return 0; }
+		auto const ret = m_data.front();
+		m_data = m_data.subspan(1);
+		return ret;
+	}
+
+	auto rest() -> std::span<std::uint8_t const> { return std::exchange(m_data, {}); }
+
+  private:
+	std::span<std::uint8_t const> m_data;
+};
+
+/// \brief Bound outputs and the args (schema) binding them, decoded from input.
+/// Keys may collide, and list / command placement is arbitrary: the parser must cope with any schema.
+struct Schema {
+	explicit Schema(Input& input) {
+		auto const count = std::size_t(input.byte() % max_args_v) + 1;
+		for (auto i = std::size_t{}; i < count; ++i) {
+			auto const kind = input.byte() % 7;
+			auto const& key = keys[i] = make_key(input.byte());
+			switch (kind) {
+			case 0: args.push_back(flag(flags[i], key)); break;
+			case 1: args.push_back(option(ints[i], key)); break;
+			case 2: args.push_back(option(strings[i], key).with_env("CLIQ_FUZZ")); break;
+			case 3: args.push_back(option(repeated[i], key).as_global()); break;
+			case 4: args.push_back(positional(strings[i], i % 2 == 0 ? ArgType::Required : ArgType::Optional, "pos")); break;
+			case 5: args.push_back(list(list_values, "list")); break;
+			default: args.push_back(command(command_args, words_v[i])); break;
+			}
+		}
+	}
+
+	static auto make_key(std::uint8_t const byte) -> std::string {
+		auto const letter = char('a' + (byte / 3) % 26);
+		auto const word = words_v[(byte / 7) % words_v.size()];
+		switch (byte % 3) {
+		case 0: return std::string{letter};
+		case 1: return std::string{word};
+		default: return std::string{letter} + ',' + std::string{word};
+		}
+	}
+
+	std::array<std::string, max_args_v> keys{};
+	std::array<bool, max_args_v> flags{};
+	std::array<int, max_args_v> ints{};
+	std::array<std::string_view, max_args_v> strings{};
+	std::array<std::vector<int>, max_args_v> repeated{};
+	std::vector<std::string_view> list_values{};
+	bool command_flag{};
+	std::vector<std::string_view> command_list{};
+	std::array<Arg, 2> command_args{flag(command_flag, "f,force"), list(command_list, "files")};
+	std::vector<Arg> args{};
+};
+
+/// \brief Remaining input split into argv words at newlines (so seed files stay readable).
+struct Argv {
+	explicit Argv(std::span<std::uint8_t const> bytes) {
+		auto const text = std::string_view{reinterpret_cast<char const*>(bytes.data()), bytes.size()};
+		for (auto first = std::size_t{}; first <= text.size();) {
+			auto const last = std::min(text.find('\n', first), text.size());
+			words.emplace_back(text.substr(first, last - first));
+			first = last + 1;
+		}
+		pointers.push_back("fuzz");
+		for (auto const& word : words) { pointers.push_back(word.c_str()); }
+	}
+
+	std::vector<std::string> words{};
+	std::vector<char const*> pointers{};
+};
+
+void run(std::span<std::uint8_t const> const data) {
+	auto input = Input{data};
+	auto const mode = input.byte() % 3;
+	auto schema = Schema{input};
+	static constexpr auto environment_v = std::array<char const*, 2>{"CLIQ_FUZZ=1", nullptr};
+	auto const config = ParseConfig{.environment = environment_v.data(), .print_errors = false};
+	auto const bytes = input.rest();
+
+	switch (mode) {
+	case 0: {
+		auto const argv = Argv{bytes};
+		[[maybe_unused]] auto const result = parse(app_info_v, schema.args, int(argv.pointers.size()), argv.pointers.data(), config);
+		break;
+	}
+	case 1: {
+		auto line = std::vector<char>(bytes.begin(), bytes.end());
+		[[maybe_unused]] auto const result = parse_line(app_info_v, schema.args, line, config);
+		break;
+	}
+	default: {
+		// parse twice: the second parse must not depend on outputs left behind by the first.
+		auto const argv = Argv{bytes};
+		auto const cli_args = std::span{argv.pointers}.subspan(1);
+		auto parser = CompiledParser{app_info_v, schema.args, "fuzz", config};
+		[[maybe_unused]] auto const first = parser.parse(cli_args);
+		[[maybe_unused]] auto const second = parser.parse(cli_args);
+		break;
+	}
+	}
+}
+} // namespace
+} // namespace cliq::fuzz
+
+extern "C" auto LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size) -> int {
+	cliq::fuzz::run({data, size});
+	return 0;
+}
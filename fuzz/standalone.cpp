@@ -0,0 +1,25 @@
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+extern "C" auto LLVMFuzzerTestOneInput(std::uint8_t const* data, std::size_t size) -> int;
+
+namespace {
+auto read_all(std::istream& in) -> std::vector<std::uint8_t> { return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}}; }
+} // namespace
+
+// replays each file passed (or stdin if none), for compilers without libFuzzer: eg afl-fuzz ... -- cliq-fuzz @@
+auto main(int argc, char** argv) -> int {
+	if (argc < 2) {
+		auto const data = read_all(std::cin);
+		return LLVMFuzzerTestOneInput(data.data(), data.size());
+	}
+	for (auto i = 1; i < argc; ++i) {
+		auto file = std::ifstream{argv[i], std::ios::binary};
+		auto const data = read_all(file);
+		LLVMFuzzerTestOneInput(data.data(), data.size());
+	}
+	return 0;
+}
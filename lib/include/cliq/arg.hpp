@@ -1,5 +1,7 @@
 #pragma once
 #include <cliq/binding.hpp>
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <span>
 #include <string_view>
@@ -17,9 +19,20 @@ struct ParamOption {
 	char letter;
 	std::string_view word;
 	std::string_view help_text;
+	/// \brief Environment variable used if the option is not passed.
+	std::string_view env{};
+	/// \brief Config file key used if the option is not passed and env is unset.
+	std::string_view config_key{};
+	/// \brief Also resolvable after any nested command is selected.
+	bool global{};
 
-	[[nodiscard]] auto assign(std::string_view const value) const -> bool { return binding.assign(data, value); }
+	[[nodiscard]] constexpr auto has_fallback() const -> bool { return !env.empty() || !config_key.empty(); }
+
+	[[nodiscard]] auto assign(std::string_view const value) const -> bool { return binding.dispatch_assign(data, value); }
 	[[nodiscard]] auto to_string() const -> std::string { return binding.to_string(data); }
+	void append_to(std::pmr::string& out) const { binding.append_to(data, out); }
+	[[nodiscard]] auto snapshot() const -> std::any { return binding.reset->snapshot(data); }
+	void restore(std::any const& snapshot) const { binding.reset->restore(data, snapshot); }
 };
 
 struct ParamPositional {
@@ -31,9 +44,21 @@ struct ParamPositional {
 	std::string_view help_text;
 
 	[[nodiscard]] constexpr auto is_required() const -> bool { return arg_type == ArgType::Required; }
-
-	[[nodiscard]] auto assign(std::string_view const value) const -> bool { return binding.assign(data, value); }
+	[[nodiscard]] constexpr auto binds_slots() const -> bool { return binding.assign_slot != nullptr; }
+	[[nodiscard]] constexpr auto binds_batches() const -> bool { return binding.assign_batch != nullptr; }
+	[[nodiscard]] constexpr auto binds_stream() const -> bool { return binding.bind_stream != nullptr; }
+
+	[[nodiscard]] auto assign(std::string_view const value) const -> bool { return binding.dispatch_assign(data, value); }
+	[[nodiscard]] auto assign_slot(char const* const* slot) const -> bool { return binding.assign_slot(data, slot); }
+	[[nodiscard]] auto assign_batch(std::span<char const* const> values, BatchExecutor const* executor = nullptr) const -> std::size_t {
+		return binding.assign_batch(data, values, executor);
+	}
+	void bind_stream(std::shared_ptr<StreamSource> source) const { binding.bind_stream(data, std::move(source)); }
+	void reserve(std::size_t const count) const { binding.reserve(data, count); }
 	[[nodiscard]] auto to_string() const -> std::string { return binding.to_string(data); }
+	void append_to(std::pmr::string& out) const { binding.append_to(data, out); }
+	[[nodiscard]] auto snapshot() const -> std::any { return binding.reset->snapshot(data); }
+	void restore(std::any const& snapshot) const { binding.reset->restore(data, snapshot); }
 };
 
 struct ParamCommand {
@@ -47,25 +72,62 @@ using Param = std::variant<ParamOption, ParamPositional, ParamCommand>;
 class Arg {
   public:
 	// Named options
-	Arg(bool& out, std::string_view key, std::string_view help_text = {});
+	constexpr Arg(bool& out, std::string_view const key, std::string_view const help_text = {})
+		: m_param(ParamOption{Binding::create<bool>(), &out, true, to_letter(key), to_word(key), help_text}) {}
 
 	template <ParamT Type>
-	Arg(Type& out, std::string_view const key, std::string_view const help_text = {})
+	constexpr Arg(Type& out, std::string_view const key, std::string_view const help_text = {})
 		: m_param(ParamOption{Binding::create<Type>(), &out, false, to_letter(key), to_word(key), help_text}) {}
 
 	// Positional arguments
 	template <ParamT Type>
-	Arg(Type& out, ArgType const type, std::string_view const name, std::string_view const help_text = {})
+	constexpr Arg(Type& out, ArgType const type, std::string_view const name, std::string_view const help_text = {})
 		: m_param(ParamPositional{type, Binding::create<Type>(), &out, false, name, help_text}) {}
 
+	template <ParamT Type, typename Alloc>
+	constexpr Arg(std::vector<Type, Alloc>& out, std::string_view const name, std::string_view const help_text = {})
+		: m_param(ParamPositional{ArgType::Optional, Binding::create<std::vector<Type, Alloc>>(), &out, true, name, help_text}) {}
+
+	constexpr Arg(ArgvSpan& out, std::string_view const name, std::string_view const help_text = {})
+		: m_param(ParamPositional{ArgType::Optional, Binding::create<ArgvSpan>(), &out, true, name, help_text}) {}
+
 	template <ParamT Type>
-	Arg(std::vector<Type>& out, std::string_view const name, std::string_view const help_text = {})
-		: m_param(ParamPositional{ArgType::Optional, Binding::create<std::vector<Type>>(), &out, true, name, help_text}) {}
+	constexpr Arg(Stream<Type>& out, std::string_view const name, std::string_view const help_text = {})
+		: m_param(ParamPositional{ArgType::Optional, Binding::create<Stream<Type>>(), &out, true, name, help_text}) {}
 
 	// Commands
-	Arg(std::span<Arg const> args, std::string_view name, std::string_view help_text = {});
+	constexpr Arg(std::span<Arg const> args, std::string_view const name, std::string_view const help_text = {})
+		: m_param(ParamCommand{args, name, help_text}) {}
+
+	/// \brief Wrap a param built by a binding helper, eg the repeatable option().
+	explicit constexpr Arg(Param const& param) : m_param(param) {}
 
-	[[nodiscard]] auto get_param() const -> Param const& { return m_param; }
+	[[nodiscard]] constexpr auto get_param() const -> Param const& { return m_param; }
+
+	/// \brief Fall back to the environment variable name if this option is not passed.
+	/// Flags are set by "1" or "true", and left unset by "0", "false" or an empty value.
+	/// No-op for positionals and commands.
+	[[nodiscard]] constexpr auto with_env(std::string_view const name) const -> Arg {
+		auto ret = *this;
+		if (auto* option = std::get_if<ParamOption>(&ret.m_param)) { option->env = name; }
+		return ret;
+	}
+
+	/// \brief Fall back to key in ParseConfig::config_file if this option is not passed (and its environment variable is unset).
+	/// No-op for positionals and commands.
+	[[nodiscard]] constexpr auto with_config(std::string_view const key) const -> Arg {
+		auto ret = *this;
+		if (auto* option = std::get_if<ParamOption>(&ret.m_param)) { option->config_key = key; }
+		return ret;
+	}
+
+	/// \brief Make this option resolvable in all nested commands too, unless shadowed by an option of theirs with the same letter or word.
+	/// No-op for positionals and commands.
+	[[nodiscard]] constexpr auto as_global() const -> Arg {
+		auto ret = *this;
+		if (auto* option = std::get_if<ParamOption>(&ret.m_param)) { option->global = true; }
+		return ret;
+	}
 
 	static constexpr auto to_letter(std::string_view const key) -> char {
 		if (key.size() == 1 || (key.size() > 2 && key[1] == ',')) { return key.front(); }
@@ -84,22 +146,70 @@ class Arg {
 	Param m_param;
 };
 
-[[nodiscard]] inline auto flag(bool& out, std::string_view const key, std::string_view const help_text = {}) -> Arg { return {out, key, help_text}; }
+[[nodiscard]] constexpr auto flag(bool& out, std::string_view const key, std::string_view const help_text = {}) -> Arg { return {out, key, help_text}; }
 
 template <ParamT Type>
-[[nodiscard]] auto option(Type& out, std::string_view const key, std::string_view const help_text = {}) -> Arg {
+[[nodiscard]] constexpr auto option(Type& out, std::string_view const key, std::string_view const help_text = {}) -> Arg {
 	return {out, key, help_text};
 }
 
+/// \brief Bind a repeatable option: each occurrence appends its value to out.
+template <ParamT Type, typename Alloc>
+[[nodiscard]] constexpr auto option(std::vector<Type, Alloc>& out, std::string_view const key, std::string_view const help_text = {}) -> Arg {
+	return Arg{ParamOption{Binding::create<std::vector<Type, Alloc>>(), &out, false, Arg::to_letter(key), Arg::to_word(key), help_text}};
+}
+
 template <ParamT Type>
-[[nodiscard]] auto positional(Type& out, ArgType const type, std::string_view const name, std::string_view const help_text = {}) -> Arg {
+[[nodiscard]] constexpr auto positional(Type& out, ArgType const type, std::string_view const name, std::string_view const help_text = {}) -> Arg {
 	return {out, type, name, help_text};
 }
 
+template <ParamT Type, typename Alloc>
+[[nodiscard]] constexpr auto list(std::vector<Type, Alloc>& out, std::string_view const name, std::string_view const help_text = {}) -> Arg {
+	return {out, name, help_text};
+}
+
+/// \brief Bind a list positional as a view over argv, without copying any strings.
+/// Requires the list's arguments to be consecutive entries in argv: interleaved options,
+/// or arguments from response files / parse_line(), are rejected as invalid values.
+[[nodiscard]] constexpr auto list(ArgvSpan& out, std::string_view const name, std::string_view const help_text = {}) -> Arg { return {out, name, help_text}; }
+
+/// \brief Bind a list positional as a lazy range over all the remaining input words, see Stream.
+/// Parsing stops at the first word of the list: no options or positionals can follow it.
 template <ParamT Type>
-[[nodiscard]] auto list(std::vector<Type>& out, std::string_view const name, std::string_view const help_text = {}) -> Arg {
+[[nodiscard]] constexpr auto stream_list(Stream<Type>& out, std::string_view const name, std::string_view const help_text = {}) -> Arg {
 	return {out, name, help_text};
 }
 
-[[nodiscard]] inline auto command(std::span<Arg const> args, std::string_view name, std::string_view help_text = {}) -> Arg { return {args, name, help_text}; }
+[[nodiscard]] constexpr auto command(std::span<Arg const> args, std::string_view name, std::string_view help_text = {}) -> Arg {
+	return {args, name, help_text};
+}
+
+/// \brief Check that no two Args in a span (or in any nested command's span) share a key.
+/// Usable in a static_assert when args are declared constexpr over variables with static storage.
+/// \returns false on duplicate letters, words or command names, or on words that shadow a builtin.
+[[nodiscard]] constexpr auto has_unique_keys(std::span<Arg const> args) -> bool {
+	constexpr auto builtins_v = std::array<std::string_view, 5>{"help", "usage", "version", "completions", "complete"};
+	auto const letter_of = [](Arg const& arg) {
+		auto const* option = std::get_if<ParamOption>(&arg.get_param());
+		return option == nullptr ? '\0' : option->letter;
+	};
+	auto const word_of = [](Arg const& arg) -> std::string_view {
+		if (auto const* option = std::get_if<ParamOption>(&arg.get_param())) { return option->word; }
+		if (auto const* command = std::get_if<ParamCommand>(&arg.get_param())) { return command->name; }
+		return {};
+	};
+
+	for (auto i = std::size_t{}; i < args.size(); ++i) {
+		auto const letter = letter_of(args[i]);
+		auto const word = word_of(args[i]);
+		if (std::holds_alternative<ParamOption>(args[i].get_param()) && std::ranges::find(builtins_v, word) != builtins_v.end()) { return false; }
+		for (auto j = i + 1; j < args.size(); ++j) {
+			if (letter != '\0' && letter_of(args[j]) == letter) { return false; }
+			if (!word.empty() && word_of(args[j]) == word && args[i].get_param().index() == args[j].get_param().index()) { return false; }
+		}
+		if (auto const* command = std::get_if<ParamCommand>(&args[i].get_param()); command != nullptr && !has_unique_keys(command->args)) { return false; }
+	}
+	return true;
+}
 } // namespace cliq
@@ -1,11 +1,32 @@
 #pragma once
 #include <cliq/concepts.hpp>
-#include <charconv>
+#include <cliq/parse_number.hpp>
+#include <cliq/value_types.hpp>
+#include <any>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace cliq {
 using Assignment = bool (*)(void* binding, std::string_view value);
 using AsString = std::string (*)(void const* binding);
+using AppendString = void (*)(void const* binding, std::pmr::string& out);
+using Snapshot = std::any (*)(void const* binding);
+using Restore = void (*)(void* binding, std::any const& snapshot);
+using Reserve = void (*)(void* binding, std::size_t count);
+using AssignSlot = bool (*)(void* binding, char const* const* slot);
+class BatchExecutor;
+using AssignBatch = std::size_t (*)(void* binding, std::span<char const* const> values, BatchExecutor const* executor);
+class StreamSource;
+using BindStream = void (*)(void* binding, std::shared_ptr<StreamSource> source);
+
+/// \brief View over consecutive argv entries, bound without copying any strings.
+using ArgvSpan = std::span<char const* const>;
 
 inline auto assign_to(bool& out, std::string_view /*value*/) -> bool {
 	out = true;
@@ -13,10 +34,8 @@ inline auto assign_to(bool& out, std::string_view /*value*/) -> bool {
 }
 
 template <NumberT Type>
-auto assign_to(Type& out, std::string_view const value) {
-	auto const* last = value.data() + value.size();
-	auto const [ptr, ec] = std::from_chars(value.data(), last, out);
-	return ptr == last && ec == std::errc{};
+auto assign_to(Type& out, std::string_view const value) -> bool {
+	return parse_number(value, out);
 }
 
 template <StringyT Type>
@@ -25,14 +44,183 @@ auto assign_to(Type& out, std::string_view const value) -> bool {
 	return true;
 }
 
-template <typename Type>
-auto assign_to(std::vector<Type>& out, std::string_view const value) -> bool {
+template <NamedEnumT Type>
+auto assign_to(Type& out, std::string_view const value) -> bool {
+	return parse_enum(value, out);
+}
+
+template <DurationT Type>
+auto assign_to(Type& out, std::string_view const value) -> bool {
+	return parse_duration(value, out);
+}
+
+template <CustomT Type>
+auto assign_to(Type& out, std::string_view const value) -> bool {
+	return cliq_assign(out, value);
+}
+
+template <typename Type, typename Alloc>
+auto assign_to(std::vector<Type, Alloc>& out, std::string_view const value) -> bool {
 	auto t = Type{};
 	if (!assign_to(t, value)) { return false; }
 	out.push_back(std::move(t));
 	return true;
 }
 
+/// \brief ArgvSpan can only be extended by argv slots, see assign_slot_to().
+inline auto assign_to(ArgvSpan& /*out*/, std::string_view /*value*/) -> bool { return false; }
+
+template <typename Type>
+void reserve_for(Type& /*out*/, std::size_t /*count*/) {}
+
+template <typename Type, typename Alloc>
+void reserve_for(std::vector<Type, Alloc>& out, std::size_t const count) {
+	out.reserve(out.size() + count);
+}
+
+/// \brief Extend out by slot, which must immediately follow the last bound slot.
+inline auto assign_slot_to(ArgvSpan& out, char const* const* slot) -> bool {
+	if (out.empty()) {
+		out = ArgvSpan{slot, 1};
+		return true;
+	}
+	if (slot != out.data() + out.size()) { return false; }
+	out = ArgvSpan{out.data(), out.size() + 1};
+	return true;
+}
+
+/// \brief Words remaining after a Stream's positional, read on demand.
+class StreamSource {
+  public:
+	StreamSource() = default;
+	StreamSource(StreamSource const&) = delete;
+	StreamSource(StreamSource&&) = delete;
+	auto operator=(StreamSource const&) -> StreamSource& = delete;
+	auto operator=(StreamSource&&) -> StreamSource& = delete;
+	virtual ~StreamSource() = default;
+
+	/// \returns false once every word has been read, or if one could not be (see get_error_input()).
+	[[nodiscard]] virtual auto next(std::string_view& out) -> bool = 0;
+	/// \returns Response file argument that could not be read, or empty for an unterminated quote, if reading stopped on an error.
+	[[nodiscard]] virtual auto get_error_input() const -> std::optional<std::string_view> = 0;
+};
+
+/// \brief Lazy, single pass range over all the input words remaining after its positional, each converted on iteration.
+/// Words are read (and response files tokenized) only as the range is iterated, so memory use does not grow with their count.
+/// Every remaining word is a value, including ones that look like options (after a first "--", which is skipped).
+/// Iteration stops early at the first word that fails to convert, see has_error().
+/// Its source is allocated from ParseConfig::resource and reads the parsed argv, so both must outlive it.
+template <ParamT Type>
+class Stream {
+  public:
+	class Iterator {
+	  public:
+		using value_type = Type;
+		using difference_type = std::ptrdiff_t;
+
+		Iterator() = default;
+		explicit Iterator(Stream& stream) : m_stream(&stream) { ++*this; }
+
+		[[nodiscard]] auto operator*() const -> Type const& { return m_value; }
+
+		auto operator++() -> Iterator& {
+			if (!m_stream->next(m_value)) { m_stream = nullptr; }
+			return *this;
+		}
+		void operator++(int) { ++*this; }
+
+		[[nodiscard]] auto operator==(std::default_sentinel_t /*end*/) const -> bool { return m_stream == nullptr; }
+
+	  private:
+		Stream* m_stream{};
+		Type m_value{};
+	};
+
+	/// \brief Read and convert the first remaining word. Words already iterated over are not revisited.
+	[[nodiscard]] auto begin() -> Iterator { return Iterator{*this}; }
+	[[nodiscard]] auto end() const -> std::default_sentinel_t { return {}; }
+
+	/// \returns true if iteration stopped before the last word.
+	[[nodiscard]] auto has_error() const -> bool { return m_error.has_value(); }
+	/// \returns Word that failed to convert (or as per StreamSource::get_error_input()), if has_error().
+	[[nodiscard]] auto get_error_input() const -> std::string_view { return m_error.value_or(std::string_view{}); }
+
+	/// \brief Bound by the parser on reaching this positional.
+	void bind(std::shared_ptr<StreamSource> source) {
+		m_source = std::move(source);
+		m_error.reset();
+	}
+
+  private:
+	auto next(Type& out) -> bool {
+		if (!m_source || m_error) { return false; }
+		auto word = std::string_view{};
+		if (!m_source->next(word)) {
+			m_error = m_source->get_error_input();
+			return false;
+		}
+		out = Type{};
+		if (!assign_to(out, word)) {
+			m_error = word;
+			return false;
+		}
+		return true;
+	}
+
+	std::shared_ptr<StreamSource> m_source{};
+	std::optional<std::string_view> m_error{};
+};
+
+/// \brief Streams can only be bound to the remaining input, see Stream::bind().
+template <ParamT Type>
+auto assign_to(Stream<Type>& /*out*/, std::string_view /*value*/) -> bool {
+	return false;
+}
+
+/// \brief Runs the chunks of a batch conversion, possibly concurrently.
+class BatchExecutor {
+  public:
+	/// \brief Convert values [first, last) of a batch.
+	/// \returns Index of the first value that failed to convert, or last.
+	using Convert = std::size_t (*)(void const* context, std::size_t first, std::size_t last);
+
+	BatchExecutor() = default;
+	BatchExecutor(BatchExecutor const&) = delete;
+	BatchExecutor(BatchExecutor&&) = delete;
+	auto operator=(BatchExecutor const&) -> BatchExecutor& = delete;
+	auto operator=(BatchExecutor&&) -> BatchExecutor& = delete;
+	virtual ~BatchExecutor() = default;
+
+	/// \brief Convert all count values, returning once every chunk has completed.
+	/// \returns Index of the first value (in order) that failed to convert, or count.
+	[[nodiscard]] virtual auto run(std::size_t count, Convert convert, void const* context) const -> std::size_t = 0;
+};
+
+/// \brief Convert values straight into the tail of out, without per-value temporaries.
+/// Conversions are split into chunks across executor's threads, if not null: Type's conversion must then be thread safe.
+/// \returns Number of values assigned: if less than values.size(), values[ret] failed to convert.
+template <typename Type, typename Alloc>
+auto assign_batch_to(std::vector<Type, Alloc>& out, std::span<char const* const> values, BatchExecutor const* executor) -> std::size_t {
+	struct Context {
+		Type* out;
+		char const* const* values;
+	};
+	static constexpr auto convert = [](void const* ptr, std::size_t const first, std::size_t const last) -> std::size_t {
+		auto const& context = *static_cast<Context const*>(ptr);
+		for (auto i = first; i < last; ++i) {
+			if (!assign_to(context.out[i], std::string_view{context.values[i]})) { return i; }
+		}
+		return last;
+	};
+
+	auto const offset = out.size();
+	out.resize(offset + values.size());
+	auto const context = Context{.out = out.data() + offset, .values = values.data()};
+	auto const ret = executor == nullptr ? convert(&context, 0, values.size()) : executor->run(values.size(), convert, &context);
+	out.resize(offset + ret);
+	return ret;
+}
+
 template <typename Type>
 auto as_string(Type const& t) -> std::string {
 	if constexpr (std::constructible_from<std::string, Type>) {
@@ -43,21 +231,224 @@ auto as_string(Type const& t) -> std::string {
 	}
 }
 
-template <typename Type>
-auto as_string(std::vector<Type> const& /*vec*/) -> std::string {
+template <NamedEnumT Type>
+auto as_string(Type const& t) -> std::string {
+	return std::string{enum_name(t)};
+}
+
+template <DurationT Type>
+auto as_string(Type const& t) -> std::string {
+	return format_duration(t);
+}
+
+template <CustomT Type>
+auto as_string(Type const& t) -> std::string {
+	if constexpr (requires { cliq_to_string(t); }) {
+		return std::string{cliq_to_string(t)};
+	} else {
+		return "...";
+	}
+}
+
+template <typename Type, typename Alloc>
+auto as_string(std::vector<Type, Alloc> const& /*vec*/) -> std::string {
+	return "...";
+}
+
+inline auto as_string(ArgvSpan const& /*span*/) -> std::string { return "..."; }
+
+template <ParamT Type>
+auto as_string(Stream<Type> const& /*stream*/) -> std::string {
 	return "...";
 }
 
+template <typename Type>
+void append_string(Type const& t, std::pmr::string& out) {
+	if constexpr (std::convertible_to<Type const&, std::string_view>) {
+		out += std::string_view{t};
+	} else if constexpr (std::floating_point<Type>) {
+		std::format_to(std::back_inserter(out), "{:f}", t); // matches std::to_string
+	} else if constexpr (NumberT<Type>) {
+		std::format_to(std::back_inserter(out), "{}", t);
+	} else {
+		out += as_string(t);
+	}
+}
+
+template <typename Type, typename Alloc>
+void append_string(std::vector<Type, Alloc> const& /*vec*/, std::pmr::string& out) {
+	out += "...";
+}
+
+inline void append_string(ArgvSpan const& /*span*/, std::pmr::string& out) { out += "..."; }
+
+template <ParamT Type>
+void append_string(Stream<Type> const& /*stream*/, std::pmr::string& out) {
+	out += "...";
+}
+
+template <typename Type>
+constexpr auto assign_slot_v = AssignSlot{};
+
+template <>
+constexpr auto assign_slot_v<ArgvSpan> = AssignSlot{[](void* binding, char const* const* slot) { return assign_slot_to(*static_cast<ArgvSpan*>(binding), slot); }};
+
+template <typename Type>
+constexpr auto assign_batch_v = AssignBatch{};
+
+/// \brief Batched for numbers and custom types: the conversions worth splitting across threads.
+template <typename Type, typename Alloc>
+	requires(NumberT<Type> || CustomT<Type>)
+constexpr auto assign_batch_v<std::vector<Type, Alloc>> = AssignBatch{[](void* binding, std::span<char const* const> values, BatchExecutor const* executor) {
+	return assign_batch_to(*static_cast<std::vector<Type, Alloc>*>(binding), values, executor);
+}};
+
+template <typename Type>
+constexpr auto bind_stream_v = BindStream{};
+
+template <ParamT Type>
+constexpr auto bind_stream_v<Stream<Type>> =
+	BindStream{[](void* binding, std::shared_ptr<StreamSource> source) { static_cast<Stream<Type>*>(binding)->bind(std::move(source)); }};
+
+/// \brief Copy of the initial value of out, or nothing if out is an empty container (restored with clear() instead).
+template <typename Type>
+auto snapshot_of(Type const& out) -> std::any {
+	if constexpr (ClearableT<Type>) {
+		if (out.empty()) { return {}; }
+	}
+	return out;
+}
+
+template <typename Type>
+void restore_to(Type& out, std::any const& snapshot) {
+	if constexpr (ClearableT<Type>) {
+		// keeps the capacity grown by earlier parses.
+		if (!snapshot.has_value()) {
+			out.clear();
+			return;
+		}
+	}
+	out = std::any_cast<Type const&>(snapshot);
+}
+
+/// \brief Snapshot / restore of a bound output, used by CompiledParser: one table per type, shared by all its Bindings.
+struct ResetOps {
+	Snapshot snapshot{};
+	Restore restore{};
+};
+
+template <typename Type>
+constexpr auto reset_ops_v = ResetOps{
+	.snapshot = [](void const* binding) -> std::any { return snapshot_of(*static_cast<Type const*>(binding)); },
+	.restore = [](void* binding, std::any const& snapshot) { restore_to(*static_cast<Type*>(binding), snapshot); },
+};
+
+/// \brief Tag for each bound type with a built-in assign_to(), dispatched with a switch instead of an indirect call.
+/// Custom covers every other type (lists, ArgvSpan, Stream, user types), which go through Binding::assign.
+enum class BindingType : std::int8_t {
+	Custom,
+	Bool,
+	String,
+	StringView,
+	SignedChar,
+	Short,
+	Int,
+	Long,
+	LongLong,
+	UnsignedChar,
+	UnsignedShort,
+	UnsignedInt,
+	UnsignedLong,
+	UnsignedLongLong,
+	Float,
+	Double,
+	LongDouble,
+};
+
+template <typename Type>
+constexpr auto binding_type_v = BindingType::Custom;
+
+template <>
+constexpr auto binding_type_v<bool> = BindingType::Bool;
+template <>
+constexpr auto binding_type_v<std::string> = BindingType::String;
+template <>
+constexpr auto binding_type_v<std::string_view> = BindingType::StringView;
+template <>
+constexpr auto binding_type_v<signed char> = BindingType::SignedChar;
+template <>
+constexpr auto binding_type_v<short> = BindingType::Short;
+template <>
+constexpr auto binding_type_v<int> = BindingType::Int;
+template <>
+constexpr auto binding_type_v<long> = BindingType::Long;
+template <>
+constexpr auto binding_type_v<long long> = BindingType::LongLong;
+template <>
+constexpr auto binding_type_v<unsigned char> = BindingType::UnsignedChar;
+template <>
+constexpr auto binding_type_v<unsigned short> = BindingType::UnsignedShort;
+template <>
+constexpr auto binding_type_v<unsigned int> = BindingType::UnsignedInt;
+template <>
+constexpr auto binding_type_v<unsigned long> = BindingType::UnsignedLong;
+template <>
+constexpr auto binding_type_v<unsigned long long> = BindingType::UnsignedLongLong;
+template <>
+constexpr auto binding_type_v<float> = BindingType::Float;
+template <>
+constexpr auto binding_type_v<double> = BindingType::Double;
+template <>
+constexpr auto binding_type_v<long double> = BindingType::LongDouble;
+
 struct Binding {
+	BindingType type{};
 	Assignment assign{};
 	AsString to_string{};
+	AppendString append_to{};
+	ResetOps const* reset{};
+	Reserve reserve{};
+	AssignSlot assign_slot{};
+	AssignBatch assign_batch{};
+	BindStream bind_stream{};
 
 	template <typename Type>
-	static auto create() -> Binding {
+	static constexpr auto create() -> Binding {
 		return Binding{
+			.type = binding_type_v<Type>,
 			.assign = [](void* binding, std::string_view const value) -> bool { return assign_to(*static_cast<Type*>(binding), value); },
 			.to_string = [](void const* binding) -> std::string { return as_string(*static_cast<Type const*>(binding)); },
+			.append_to = [](void const* binding, std::pmr::string& out) { append_string(*static_cast<Type const*>(binding), out); },
+			.reset = &reset_ops_v<Type>,
+			.reserve = [](void* binding, std::size_t const count) { reserve_for(*static_cast<Type*>(binding), count); },
+			.assign_slot = assign_slot_v<Type>,
+			.assign_batch = assign_batch_v<Type>,
+			.bind_stream = bind_stream_v<Type>,
 		};
 	}
+
+	/// \brief Assign value to data: inline for built-in types, through assign for Custom ones.
+	[[nodiscard]] auto dispatch_assign(void* data, std::string_view const value) const -> bool {
+		switch (type) {
+		case BindingType::Custom: break;
+		case BindingType::Bool: return assign_to(*static_cast<bool*>(data), value);
+		case BindingType::String: return assign_to(*static_cast<std::string*>(data), value);
+		case BindingType::StringView: return assign_to(*static_cast<std::string_view*>(data), value);
+		case BindingType::SignedChar: return parse_number(value, *static_cast<signed char*>(data));
+		case BindingType::Short: return parse_number(value, *static_cast<short*>(data));
+		case BindingType::Int: return parse_number(value, *static_cast<int*>(data));
+		case BindingType::Long: return parse_number(value, *static_cast<long*>(data));
+		case BindingType::LongLong: return parse_number(value, *static_cast<long long*>(data));
+		case BindingType::UnsignedChar: return parse_number(value, *static_cast<unsigned char*>(data));
+		case BindingType::UnsignedShort: return parse_number(value, *static_cast<unsigned short*>(data));
+		case BindingType::UnsignedInt: return parse_number(value, *static_cast<unsigned int*>(data));
+		case BindingType::UnsignedLong: return parse_number(value, *static_cast<unsigned long*>(data));
+		case BindingType::UnsignedLongLong: return parse_number(value, *static_cast<unsigned long long*>(data));
+		case BindingType::Float: return parse_number(value, *static_cast<float*>(data));
+		case BindingType::Double: return parse_number(value, *static_cast<double*>(data));
+		case BindingType::LongDouble: return parse_number(value, *static_cast<long double*>(data));
+		}
+		return assign(data, value);
+	}
 };
 } // namespace cliq
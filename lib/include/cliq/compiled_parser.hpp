@@ -0,0 +1,42 @@
+#pragma once
+#include <cliq/app_info.hpp>
+#include <cliq/arg.hpp>
+#include <cliq/parse_config.hpp>
+#include <cliq/result.hpp>
+#include <memory>
+
+namespace cliq {
+/// \brief Reusable parser for many command lines against the same args.
+/// Builds lookup tables for args and all nested commands once, and snapshots the
+/// initial value of every bound output, which is restored before each parse
+/// (outputs that start out as empty containers, eg lists, are cleared instead).
+/// Args (and anything they reference) must outlive this object.
+class CompiledParser {
+  public:
+	explicit CompiledParser(AppInfo const& info, std::span<Arg const> args, std::string_view exe_name = "<app>", ParseConfig const& config = {});
+
+	CompiledParser(CompiledParser&&) noexcept;
+	auto operator=(CompiledParser&&) noexcept -> CompiledParser&;
+	CompiledParser(CompiledParser const&) = delete;
+	auto operator=(CompiledParser const&) = delete;
+	~CompiledParser();
+
+	/// \brief Reset bound outputs and parse passed arguments.
+	/// \param cli_args Arguments, excluding the executable name.
+	/// \returns Result of parsing.
+	[[nodiscard]] auto parse(std::span<char const* const> cli_args) -> Result;
+
+	/// \brief Reset bound outputs and parse a command line string.
+	/// The line is split into shell-style words in place (see cliq::parse_line()).
+	/// \param line Mutable command line buffer, excluding the executable name.
+	/// \returns Result of parsing.
+	[[nodiscard]] auto parse_line(std::span<char> line) -> Result;
+
+	/// \brief Restore all bound outputs to their values at construction.
+	void reset();
+
+  private:
+	struct Impl;
+	std::unique_ptr<Impl> m_impl;
+};
+} // namespace cliq
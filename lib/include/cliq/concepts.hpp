@@ -1,8 +1,15 @@
 #pragma once
+#include <chrono>
 #include <concepts>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace cliq {
+/// \brief Specialize with a static constexpr member `entries` (eg std::array of EnumName) to bind an enum by name.
+template <typename Type>
+struct EnumNames;
+
 template <typename Type>
 concept StringyT = std::same_as<Type, std::string> || std::same_as<Type, std::string_view>;
 
@@ -10,7 +17,27 @@ template <typename Type>
 concept NumberT = !std::same_as<bool, Type> && (std::integral<Type> || std::floating_point<Type>);
 
 template <typename Type>
-concept ParamT = StringyT<Type> || NumberT<Type>;
+concept NamedEnumT = std::is_enum_v<Type> && requires { EnumNames<Type>::entries; };
+
+template <typename Type>
+concept DurationT = std::same_as<Type, std::chrono::duration<typename Type::rep, typename Type::period>>;
+
+/// \brief User type bound via an ADL-visible `bool cliq_assign(Type&, std::string_view)`.
+/// An optional `cliq_to_string(Type const&)` is used to print default values in usage/help.
+/// Types with built-in conversions (including named enums and durations) never use cliq_assign.
+template <typename Type>
+concept CustomT = !StringyT<Type> && !NumberT<Type> && !NamedEnumT<Type> && !DurationT<Type> && requires(Type& out, std::string_view const value) {
+	{ cliq_assign(out, value) } -> std::same_as<bool>;
+};
+
+template <typename Type>
+concept ParamT = StringyT<Type> || NumberT<Type> || NamedEnumT<Type> || DurationT<Type> || CustomT<Type>;
+
+template <typename Type>
+concept ClearableT = requires(Type& t) {
+	{ t.empty() } -> std::convertible_to<bool>;
+	t.clear();
+};
 
 template <typename Type>
 concept NotBoolT = !std::same_as<Type, bool>;
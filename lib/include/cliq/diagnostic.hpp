@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace cliq {
+/// \brief Kind of error that failed parsing, and meaning of Diagnostic::input / value.
+enum class DiagnosticKind : std::int8_t {
+	None,
+	InvalidValue,			// input: option / positional name, value: offending value.
+	InvalidOption,			// input: unknown option letter.
+	UnrecognizedOption,		// input: unknown option word, candidates[0]: closest known word, if any.
+	AmbiguousOption,		// input: abbreviation, candidates: first two of the words it abbreviates (all are printed).
+	UnrecognizedCommand,	// input: unknown command name, candidates[0]: closest known name, if any.
+	ExtraneousArgument,		// input: unexpected argument.
+	OptionRequiresArgument, // input: option letter / word.
+	OptionIsFlag,			// input: option letter / word.
+	UnterminatedQuote,		//
+	UnreadableResponseFile, // input: @path argument.
+	InvalidEnvironment,		// input: environment variable name, value: its value.
+	InvalidConfig,			// input: config key, value: its value.
+	MissingArgument,		// input: positional name, or "command".
+};
+
+/// \brief Structured description of a parse error.
+/// Views point into argv, args, or storage kept alive by the Result holding this.
+struct Diagnostic {
+	DiagnosticKind kind{};
+	/// \brief Index of the offending input word (excluding the executable, after response file expansion).
+	/// std::string_view::npos for errors not caused by an input word.
+	std::size_t index{std::string_view::npos};
+	std::string_view exe_name{};
+	/// \brief Selected command, if any.
+	std::string_view command{};
+	std::string_view input{};
+	std::string_view value{};
+	std::array<std::string_view, 2> candidates{};
+
+	auto operator==(Diagnostic const& rhs) const -> bool = default;
+};
+
+/// \brief Format a diagnostic the way it is printed to stderr: "<exe> [command]: <message>\n",
+/// followed by a pointer to --help for usage errors.
+/// An AmbiguousOption lists only the two candidates kept in the diagnostic.
+/// \returns Empty string if diagnostic.kind is None.
+[[nodiscard]] auto format_diagnostic(Diagnostic const& diagnostic, std::pmr::memory_resource& resource = *std::pmr::get_default_resource())
+	-> std::pmr::string;
+} // namespace cliq
@@ -2,8 +2,29 @@
 #include <cliq/app_info.hpp>
 #include <cliq/arg.hpp>
 #include <cliq/build_version.hpp>
+#include <cliq/compiled_parser.hpp>
+#include <cliq/parse_config.hpp>
 #include <cliq/result.hpp>
+#include <cliq/string_pool.hpp>
+#include <cliq/trace.hpp>
 
 namespace cliq {
-[[nodiscard]] auto parse(AppInfo const& info, std::span<Arg const> args, int argc, char const* const* argv) -> Result;
-}
+/// \brief Parse command line arguments into bound outputs.
+/// \param info Application info used in help / version text.
+/// \param args Arguments to parse into.
+/// \param argc Argument count, including the executable name.
+/// \param argv Argument vector, including the executable name.
+/// \param config Parser configuration.
+/// \returns Result of parsing.
+[[nodiscard]] auto parse(AppInfo const& info, std::span<Arg const> args, int argc, char const* const* argv, ParseConfig const& config = {}) -> Result;
+
+/// \brief Parse a command line string (excluding the executable name) into bound outputs.
+/// The line is split into shell-style words in place: quotes and escapes are removed by compacting
+/// each word within line, so string_view outputs point into it and must not outlive it.
+/// \param info Application info used in help / version text.
+/// \param args Arguments to parse into.
+/// \param line Mutable command line buffer.
+/// \param config Parser configuration.
+/// \returns Result of parsing.
+[[nodiscard]] auto parse_line(AppInfo const& info, std::span<Arg const> args, std::span<char> line, ParseConfig const& config = {}) -> Result;
+} // namespace cliq
@@ -0,0 +1,78 @@
+#pragma once
+#include <cliq/compiled_parser.hpp>
+#include <algorithm>
+#include <concepts>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace cliq {
+/// \brief Configuration for parse_batch().
+struct BatchConfig {
+	/// \brief Executable name used in diagnostics.
+	std::string_view exe_name{"<app>"};
+	/// \brief Threads to split command lines across, each with its own CompiledParser and scratch slot.
+	/// 0 uses std::thread::hardware_concurrency(). ParseConfig::resource and ParseConfig::tracer are shared by all threads,
+	/// so both must be thread safe if more than 1 (JsonLinesTracer is not).
+	std::size_t threads{1};
+	/// \brief Configuration for each parse. print_errors is ignored: errors are never printed.
+	ParseConfig parse{};
+};
+
+namespace detail {
+/// \brief Indices of the jobs of a parse_batch(), shared by all its threads.
+class BatchQueue {
+  public:
+	/// \brief Called once on each thread, taking jobs from queue until it runs out.
+	using Worker = void (*)(void const* context, BatchQueue& queue);
+
+	/// \brief Run worker on threads threads (0: one per hardware thread), including the calling one, but not more than count.
+	/// Once every thread has returned, rethrows the first exception a worker threw (after which no more jobs are handed out).
+	static void run(std::size_t count, std::size_t threads, Worker worker, void const* context);
+
+	BatchQueue() = default;
+	BatchQueue(BatchQueue const&) = delete;
+	BatchQueue(BatchQueue&&) = delete;
+	auto operator=(BatchQueue const&) -> BatchQueue& = delete;
+	auto operator=(BatchQueue&&) -> BatchQueue& = delete;
+	virtual ~BatchQueue() = default;
+
+	/// \returns Index of a job no other thread has taken, or a value >= count once all have been.
+	[[nodiscard]] virtual auto take() -> std::size_t = 0;
+};
+} // namespace detail
+
+/// \brief Parse many independent command lines against the same args, each into its own output slot.
+/// bind(slot) returns the args (eg a std::array<Arg, N>) binding the members of a slot. It is called once per thread,
+/// for a scratch slot whose lookups are compiled once and reused: after parsing jobs[i], the scratch slot is copied to slots[i].
+/// Builtins (--help etc) still print to stdout. An exception thrown on any thread (eg by bind or a custom conversion)
+/// stops the batch, and is rethrown on the calling thread once every thread has finished.
+/// \param jobs Command lines, each excluding the executable name. Only the first slots.size() are parsed.
+/// \param slots Contiguous range of output slots (eg a std::array, std::vector, or std::span).
+/// \returns Result of each parsed command line, in order.
+template <std::ranges::contiguous_range Slots, typename Bind>
+	requires(std::ranges::sized_range<Slots> && std::copyable<std::ranges::range_value_t<Slots>> &&
+			 std::default_initializable<std::ranges::range_value_t<Slots>> && std::invocable<Bind const&, std::ranges::range_value_t<Slots>&>)
+[[nodiscard]] auto parse_batch(AppInfo const& info, std::span<std::span<char const* const> const> jobs, Slots&& slots, Bind const& bind,
+							   BatchConfig const& config = {}) -> std::vector<Result> {
+	using Slot = std::ranges::range_value_t<Slots>;
+	auto const out = std::span{std::ranges::data(slots), std::ranges::size(slots)};
+	auto const count = std::min(jobs.size(), out.size());
+	auto ret = std::vector<Result>(count);
+	auto parse_config = config.parse;
+	parse_config.print_errors = false;
+
+	auto const work = [&](detail::BatchQueue& queue) {
+		auto scratch = Slot{};
+		auto const args = bind(scratch);
+		auto parser = CompiledParser{info, args, config.exe_name, parse_config};
+		for (auto i = queue.take(); i < count; i = queue.take()) {
+			ret[i] = parser.parse(jobs[i]);
+			out[i] = scratch;
+		}
+	};
+	static constexpr auto worker_v = [](void const* context, detail::BatchQueue& queue) { (*static_cast<decltype(work)*>(context))(queue); };
+	detail::BatchQueue::run(count, config.threads, worker_v, &work);
+	return ret;
+}
+} // namespace cliq
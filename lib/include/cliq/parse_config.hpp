@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+namespace cliq {
+class Tracer;
+
+/// \brief Parser configuration.
+struct ParseConfig {
+	/// \brief Memory resource for all internal allocations: lookup tables, error and help text.
+	/// Uses std::pmr::get_default_resource() if null.
+	/// A Result keeps memory from it (the entered command path, open response files), so it must outlive every Result returned and every Stream read from after parsing.
+	std::pmr::memory_resource* resource{};
+
+	/// \brief Expand args of the form @path into the whitespace separated (shell-quoted) words of the file at path.
+	/// Files are memory mapped and tokenized lazily; string_view outputs point into the mapping,
+	/// which is kept alive by the returned Result.
+	bool response_files{};
+
+	/// \brief Null-terminated KEY=VALUE array consulted for options bound with Arg::with_env().
+	/// Uses the process environment if null.
+	char const* const* environment{};
+
+	/// \brief Null-terminated path to a file of "key = value" lines consulted for options bound with Arg::with_config().
+	/// A missing file is treated as empty.
+	char const* config_file{};
+
+	/// \brief Print a diagnostic to stderr as soon as parsing fails.
+	/// If false, nothing is formatted or printed: see Result::get_diagnostic() and format_diagnostic().
+	bool print_errors{true};
+
+	/// \brief Threads converting the values of a number or custom type list positional, if more than 1.
+	/// Only runs of several thousand consecutive argv values are split up; the first invalid value
+	/// in argv order is reported regardless. Custom conversions (cliq_assign) must be safe to call concurrently;
+	/// an exception thrown by one is rethrown from parse(), as a serial parse would throw it.
+	std::size_t batch_threads{};
+
+	/// \brief Receives an event for every token parsed, if set.
+	/// Ignored unless cliq was built with tracing (see trace_enabled_v).
+	Tracer* tracer{};
+
+	[[nodiscard]] auto get_resource() const -> std::pmr::memory_resource& { return resource == nullptr ? *std::pmr::get_default_resource() : *resource; }
+};
+} // namespace cliq
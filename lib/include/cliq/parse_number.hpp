@@ -0,0 +1,67 @@
+#pragma once
+#include <cliq/concepts.hpp>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace cliq {
+namespace detail {
+/// \brief Check whether 8 bytes (loaded little-endian) are all ASCII digits.
+constexpr auto is_eight_digits(std::uint64_t const chunk) -> bool {
+	return ((chunk & 0xf0f0f0f0f0f0f0f0) == 0x3030303030303030) && (((chunk + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) == 0x3030303030303030);
+}
+
+/// \brief Convert 8 ASCII digits (loaded little-endian) to their value, combining pairs of lanes in 3 multiplies.
+constexpr auto eight_digits_value(std::uint64_t chunk) -> std::uint64_t {
+	constexpr auto mask_v = std::uint64_t{0x000000ff000000ff};
+	constexpr auto mul1_v = std::uint64_t{100 + (1000000ull << 32)};
+	constexpr auto mul2_v = std::uint64_t{1 + (10000ull << 32)};
+	chunk -= 0x3030303030303030;
+	chunk = (chunk * 10) + (chunk >> 8);
+	return (((chunk & mask_v) * mul1_v) + (((chunk >> 16) & mask_v) * mul2_v)) >> 32;
+}
+
+/// \brief Accumulate a run of decimal digits too short to overflow std::uint64_t.
+/// \returns false if any character is not a digit.
+inline auto accumulate_digits(std::string_view digits, std::uint64_t& out) -> bool {
+	if constexpr (std::endian::native == std::endian::little) {
+		while (digits.size() >= 8) {
+			auto chunk = std::uint64_t{};
+			std::memcpy(&chunk, digits.data(), sizeof(chunk));
+			if (!is_eight_digits(chunk)) { return false; }
+			out = (out * 100000000) + eight_digits_value(chunk);
+			digits = digits.substr(8);
+		}
+	}
+	for (char const c : digits) {
+		if (c < '0' || c > '9') { return false; }
+		out = (out * 10) + std::uint64_t(c - '0');
+	}
+	return true;
+}
+} // namespace detail
+
+/// \brief Convert value to a number, with the same semantics as std::from_chars over the whole of value.
+/// Integers short enough that they cannot overflow are converted 8 digits at a time (SWAR);
+/// everything else (floats, long or malformed integers) goes through std::from_chars.
+template <NumberT Type>
+auto parse_number(std::string_view const value, Type& out) -> bool {
+	if constexpr (std::integral<Type> && sizeof(Type) <= sizeof(std::uint64_t)) {
+		auto const is_negative = std::signed_integral<Type> && value.starts_with('-');
+		auto const digits = is_negative ? value.substr(1) : value;
+		if (!digits.empty() && digits.size() <= std::size_t(std::numeric_limits<Type>::digits10)) {
+			auto magnitude = std::uint64_t{};
+			if (detail::accumulate_digits(digits, magnitude)) {
+				out = is_negative ? Type(-static_cast<std::int64_t>(magnitude)) : Type(magnitude);
+				return true;
+			}
+		}
+	}
+	auto const* last = value.data() + value.size();
+	auto const [ptr, ec] = std::from_chars(value.data(), last, out);
+	return ptr == last && ec == std::errc{};
+}
+} // namespace cliq
@@ -1,7 +1,12 @@
 #pragma once
 #include <cliq/arg.hpp>
+#include <cliq/diagnostic.hpp>
+#include <algorithm>
 #include <cstdlib>
+#include <memory>
 #include <optional>
+#include <span>
+#include <utility>
 
 namespace cliq {
 /// \brief Error parsing passed arguments.
@@ -10,10 +15,16 @@ enum class ParseError : int {
 	InvalidOption,
 	InvalidArgument,
 	MissingArgument,
+	AmbiguousOption,
 };
 
 struct ExecutedBuiltin {};
 
+namespace detail {
+/// \brief Passkey for the Result constructors reserved to cliq (defined privately).
+class ResultKey;
+} // namespace detail
+
 /// \brief Result of parsing args / running selected command.
 class Result {
   public:
@@ -21,20 +32,43 @@ class Result {
 
 	constexpr Result(std::string_view command_name) : m_command_name(command_name) {}
 	constexpr Result(ParseError parse_error) : m_parse_error(parse_error) {}
+	constexpr Result(ParseError parse_error, Diagnostic const& diagnostic) : m_parse_error(parse_error), m_diagnostic(diagnostic) {}
 	constexpr Result(ExecutedBuiltin const& /*eb*/) : m_executed_builtin(true) {}
 
+	/// \brief Attach storage that outputs may point into to result, and the entered command path (which may point into it too).
+	explicit Result(detail::ResultKey const& /*key*/, Result result, std::shared_ptr<void const> storage, std::span<std::string_view const> command_path = {})
+		: Result(std::move(result)) {
+		m_storage = std::move(storage);
+		m_command_path = command_path;
+	}
+
 	/// \brief Check if cliq executed a builtin option (like "--help")
 	/// \returns true if cliq executed a builtin option.
 	[[nodiscard]] constexpr auto executed_builtin() const -> bool { return m_executed_builtin; }
 
 	/// \brief Get the entered command name.
-	/// \returns Entered command name matching passed args, if any.
+	/// \returns Innermost entered command name matching passed args, if any.
 	[[nodiscard]] constexpr auto get_command_name() const -> std::string_view { return m_command_name; }
 
+	/// \brief Get the names of all entered (nested) commands.
+	/// \returns Entered command names, outermost first.
+	[[nodiscard]] constexpr auto get_command_path() const -> std::span<std::string_view const> { return m_command_path; }
+
 	/// \brief Get the error that occurred during argument parsing.
 	/// \returns Argument parsing error, if any.
 	[[nodiscard]] constexpr auto get_parse_error() const -> std::optional<ParseError> { return m_parse_error; }
 
+	/// \brief Get the details of the error that occurred during argument parsing.
+	/// \returns Diagnostic of kind None if no error occurred.
+	[[nodiscard]] constexpr auto get_diagnostic() const -> Diagnostic const& { return m_diagnostic; }
+
+	/// \brief Get the known option word or command name closest to an unrecognized one.
+	/// \returns Suggested word / name (without leading dashes), if any.
+	[[nodiscard]] constexpr auto get_suggestion() const -> std::string_view {
+		auto const is_unrecognized = m_diagnostic.kind == DiagnosticKind::UnrecognizedOption || m_diagnostic.kind == DiagnosticKind::UnrecognizedCommand;
+		return is_unrecognized ? m_diagnostic.candidates[0] : std::string_view{};
+	}
+
 	/// \brief Get the return code for main.
 	/// \returns EXIT_FAILURE on parse error, else EXIT_SUCCESS.
 	[[nodiscard]] constexpr auto get_return_code() const -> int { return m_parse_error ? int(*m_parse_error) : EXIT_SUCCESS; }
@@ -48,11 +82,19 @@ class Result {
 	constexpr explicit operator bool() const { return !early_return(); }
 
 	/// \brief Compare equality with another ParseResult.
-	auto operator==(Result const& rhs) const -> bool = default;
+	/// Attached storage is not compared.
+	auto operator==(Result const& rhs) const -> bool {
+		return m_command_name == rhs.m_command_name && std::ranges::equal(m_command_path, rhs.m_command_path) && m_parse_error == rhs.m_parse_error &&
+			   m_diagnostic == rhs.m_diagnostic && m_executed_builtin == rhs.m_executed_builtin;
+	}
 
   private:
 	std::string_view m_command_name{};
+	std::span<std::string_view const> m_command_path{};
 	std::optional<ParseError> m_parse_error{};
+	Diagnostic m_diagnostic{};
 	bool m_executed_builtin{};
+	// keeps alive any storage outputs may point into (eg mapped response files).
+	std::shared_ptr<void const> m_storage{};
 };
 } // namespace cliq
@@ -0,0 +1,58 @@
+#pragma once
+#include <cliq/arg.hpp>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace cliq {
+/// \brief Deduplicating arena of strings.
+/// Each distinct string is copied once; views returned by intern() stay valid for the lifetime of the pool.
+class StringPool {
+  public:
+	explicit StringPool(std::pmr::memory_resource& resource = *std::pmr::get_default_resource());
+
+	StringPool(StringPool const&) = delete;
+	StringPool(StringPool&&) = delete;
+	auto operator=(StringPool const&) -> StringPool& = delete;
+	auto operator=(StringPool&&) -> StringPool& = delete;
+	~StringPool() = default;
+
+	/// \returns View of the pooled copy of text, stored on first use.
+	[[nodiscard]] auto intern(std::string_view text) -> std::string_view;
+
+	/// \returns Number of distinct strings stored.
+	[[nodiscard]] auto size() const -> std::size_t { return m_strings.size(); }
+
+  private:
+	std::pmr::monotonic_buffer_resource m_arena;
+	std::pmr::unordered_set<std::string_view> m_strings;
+};
+
+/// \brief Repeatable string output whose values are interned in a StringPool, in the order they were passed.
+/// Bind with option() for a repeatable option, or list() for a list positional.
+class InternedStrings {
+  public:
+	explicit InternedStrings(StringPool& pool) : m_pool(&pool) {}
+
+	[[nodiscard]] auto get_values() const -> std::span<std::string_view const> { return m_values; }
+	[[nodiscard]] auto empty() const -> bool { return m_values.empty(); }
+
+	void push_back(std::string_view const text) { m_values.push_back(m_pool->intern(text)); }
+	void clear() { m_values.clear(); }
+
+	friend auto cliq_assign(InternedStrings& out, std::string_view const value) -> bool {
+		out.push_back(value);
+		return true;
+	}
+
+  private:
+	StringPool* m_pool;
+	std::vector<std::string_view> m_values{};
+};
+
+[[nodiscard]] constexpr auto list(InternedStrings& out, std::string_view const name, std::string_view const help_text = {}) -> Arg {
+	return Arg{ParamPositional{ArgType::Optional, Binding::create<InternedStrings>(), &out, true, name, help_text}};
+}
+} // namespace cliq
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace cliq {
+enum class TokenType {
+	None,
+	Option,	   // -[-][A-z]+[=[A-z]+]
+	Argument,  // [A-z]+
+	ForceArgs, // --
+};
+
+enum class OptionType {
+	None,
+	Letters, // -[A-z]+[=[A-z]+]
+	Word,	 // --[A-z]+[=[A-z]+]
+};
+} // namespace cliq
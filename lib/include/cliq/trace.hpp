@@ -0,0 +1,75 @@
+#pragma once
+#include <cliq/arg.hpp>
+#include <cliq/token_type.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+
+namespace cliq {
+/// \brief Whether cliq was built with parse tracing (CMake option CLIQ_TRACE).
+/// If false, ParseConfig::tracer is ignored and the parser contains no tracing code.
+#if defined(CLIQ_TRACE)
+constexpr bool trace_enabled_v{true};
+#else
+constexpr bool trace_enabled_v{false};
+#endif
+
+/// \brief What the parser did with a token.
+enum class TraceOutcome : std::int8_t {
+	None,			 // nothing to do (eg "--").
+	Assigned,		 // option / positional output assigned.
+	SelectedCommand, // command selected.
+	ExecutedBuiltin, // builtin (eg "--help") executed.
+	Failed,			 // parsing failed at this token: see Result::get_diagnostic().
+};
+
+/// \brief Record of parsing one token.
+struct TraceEvent {
+	/// \brief Index of the input word the token was read from (after response file expansion).
+	std::size_t index{};
+	/// \brief Number of input words consumed: more than 1 for option values in the next word, and batches of list positionals.
+	std::size_t count{1};
+	/// \brief Unprocessed input word.
+	std::string_view input{};
+	TokenType token_type{};
+	OptionType option_type{};
+	/// \brief Matched param, if any: the last one for a run of letters.
+	ParamOption const* option{};
+	ParamPositional const* positional{};
+	ParamCommand const* command{};
+	TraceOutcome outcome{};
+	/// \brief Time spent parsing the token, including assigning to outputs.
+	std::chrono::nanoseconds elapsed{};
+};
+
+/// \brief Receives an event for every token parsed.
+class Tracer {
+  public:
+	Tracer() = default;
+	Tracer(Tracer const&) = default;
+	Tracer(Tracer&&) = default;
+	auto operator=(Tracer const&) -> Tracer& = default;
+	auto operator=(Tracer&&) -> Tracer& = default;
+	virtual ~Tracer() = default;
+
+	virtual void on_token(TraceEvent const& event) = 0;
+};
+
+/// \brief Append event as a single line JSON object, terminated by a newline.
+void append_json_line(TraceEvent const& event, std::pmr::string& out);
+
+/// \brief Tracer that collects events as JSON lines.
+class JsonLinesTracer : public Tracer {
+  public:
+	explicit JsonLinesTracer(std::pmr::memory_resource& resource = *std::pmr::get_default_resource()) : m_lines(&resource) {}
+
+	void on_token(TraceEvent const& event) override { append_json_line(event, m_lines); }
+
+	[[nodiscard]] auto get_lines() const -> std::string_view { return m_lines; }
+	void clear() { m_lines.clear(); }
+
+  private:
+	std::pmr::string m_lines;
+};
+} // namespace cliq
@@ -0,0 +1,210 @@
+#pragma once
+#include <cliq/concepts.hpp>
+#include <cliq/parse_number.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <ratio>
+#include <string>
+#include <string_view>
+
+namespace cliq {
+/// \brief Entry in an EnumNames table.
+template <typename Type>
+struct EnumName {
+	Type value;
+	std::string_view name;
+};
+
+template <NamedEnumT Type>
+constexpr auto parse_enum(std::string_view const value, Type& out) -> bool {
+	for (auto const& entry : EnumNames<Type>::entries) {
+		if (entry.name == value) {
+			out = entry.value;
+			return true;
+		}
+	}
+	return false;
+}
+
+template <NamedEnumT Type>
+constexpr auto enum_name(Type const value) -> std::string_view {
+	for (auto const& entry : EnumNames<Type>::entries) {
+		if (entry.value == value) { return entry.name; }
+	}
+	return {};
+}
+
+/// \brief Unit suffix for a duration period, empty if it has none.
+template <typename Period>
+constexpr auto duration_suffix() -> std::string_view {
+	if constexpr (std::same_as<Period, std::nano>) {
+		return "ns";
+	} else if constexpr (std::same_as<Period, std::micro>) {
+		return "us";
+	} else if constexpr (std::same_as<Period, std::milli>) {
+		return "ms";
+	} else if constexpr (std::same_as<Period, std::ratio<1>>) {
+		return "s";
+	} else if constexpr (std::same_as<Period, std::ratio<60>>) {
+		return "min";
+	} else if constexpr (std::same_as<Period, std::ratio<3600>>) {
+		return "h";
+	} else if constexpr (std::same_as<Period, std::ratio<86400>>) {
+		return "d";
+	} else {
+		return {};
+	}
+}
+
+namespace detail {
+/// \brief Parse a decimal count exactly, as mantissa / scale (a power of 10), eg "1.25" as 125 / 100.
+inline auto parse_decimal(std::string_view const count, std::int64_t& mantissa, std::int64_t& scale) -> bool {
+	auto const dot = count.find('.');
+	if (dot == std::string_view::npos) {
+		scale = 1;
+		return parse_number(count, mantissa);
+	}
+	auto const is_negative = count.starts_with('-');
+	auto const whole = count.substr(is_negative ? 1 : 0, dot - (is_negative ? 1 : 0));
+	auto fraction = count.substr(dot + 1);
+	if (fraction.empty() || fraction.find_first_not_of("0123456789") != std::string_view::npos) { return false; }
+	while (fraction.ends_with('0')) { fraction.remove_suffix(1); }
+	if (fraction.size() > std::size_t(std::numeric_limits<std::int64_t>::digits10)) { return false; }
+
+	auto magnitude = std::uint64_t{};
+	if (!parse_number(whole, magnitude)) { return false; }
+	auto digits = std::uint64_t{};
+	scale = 1;
+	for (char const c : fraction) {
+		digits = (digits * 10) + std::uint64_t(c - '0');
+		scale *= 10;
+	}
+	auto const max = std::uint64_t(std::numeric_limits<std::int64_t>::max());
+	if (magnitude > (max - digits) / std::uint64_t(scale)) { return false; }
+	mantissa = std::int64_t((magnitude * std::uint64_t(scale)) + digits);
+	if (is_negative) { mantissa = -mantissa; }
+	return true;
+}
+} // namespace detail
+
+/// \brief Parse a count with an optional unit suffix (ns, us, ms, s, m|min, h, d), eg "250ms".
+/// A bare count is in the units of Type. Integral durations accept a fractional count (eg "1.5s")
+/// only if it converts exactly, and reject values that would be truncated or overflow.
+template <DurationT Type>
+auto parse_duration(std::string_view const value, Type& out) -> bool {
+	using Rep = typename Type::rep;
+	auto const split = value.find_first_not_of("+-.0123456789");
+	auto const count = value.substr(0, split);
+	auto const unit = split == std::string_view::npos ? std::string_view{} : value.substr(split);
+
+	auto const convert = [&]<typename Period>(Period /*period*/) -> bool {
+		if constexpr (std::floating_point<Rep>) {
+			auto source = Rep{};
+			if (!parse_number(count, source)) { return false; }
+			out = std::chrono::duration_cast<Type>(std::chrono::duration<Rep, Period>{source});
+			return true;
+		} else {
+			auto num = std::int64_t{};
+			auto den = std::int64_t{};
+			if (!detail::parse_decimal(count, num, den)) { return false; }
+			// num / den Periods is num * Ratio::num / (den * Ratio::den) Type units: cancel common factors,
+			// and the result is exact only if no denominator remains (both fractions are already reduced).
+			using Ratio = std::ratio_divide<Period, typename Type::period>;
+			auto const common = std::gcd(num, den);
+			num /= common;
+			den /= common;
+			auto const num_common = std::gcd(num, std::int64_t{Ratio::den});
+			auto const den_common = std::gcd(den, std::int64_t{Ratio::num});
+			if (den / den_common != 1 || Ratio::den / num_common != 1) { return false; }
+			num /= num_common;
+			auto const scale = std::int64_t{Ratio::num} / den_common;
+
+			constexpr auto max_v = std::int64_t(std::min<std::uint64_t>(std::numeric_limits<Rep>::max(), std::numeric_limits<std::int64_t>::max()));
+			constexpr auto min_v = std::int64_t(std::numeric_limits<Rep>::lowest());
+			if (num > max_v / scale || num < min_v / scale) { return false; }
+			out = Type{Rep(num * scale)};
+			return true;
+		}
+	};
+
+	if (unit.empty()) { return convert(typename Type::period{}); }
+	if (unit == "ns") { return convert(std::nano{}); }
+	if (unit == "us") { return convert(std::micro{}); }
+	if (unit == "ms") { return convert(std::milli{}); }
+	if (unit == "s") { return convert(std::ratio<1>{}); }
+	if (unit == "m" || unit == "min") { return convert(std::ratio<60>{}); }
+	if (unit == "h") { return convert(std::ratio<3600>{}); }
+	if (unit == "d") { return convert(std::ratio<86400>{}); }
+	return false;
+}
+
+template <DurationT Type>
+auto format_duration(Type const& duration) -> std::string {
+	return std::format("{}{}", duration.count(), duration_suffix<typename Type::period>());
+}
+
+/// \brief Size in bytes, parsed from a count with an optional unit suffix, eg "64MiB".
+/// Suffixes: B; kB, MB, GB, TB (powers of 1000); KiB, MiB, GiB, TiB and K, M, G, T (powers of 1024).
+struct ByteSize {
+	std::uint64_t bytes{};
+
+	auto operator==(ByteSize const&) const -> bool = default;
+
+	friend auto cliq_assign(ByteSize& out, std::string_view const value) -> bool {
+		struct Unit {
+			std::string_view suffix;
+			std::uint64_t scale;
+		};
+		static constexpr auto units_v = std::array{
+			Unit{"", 1},
+			Unit{"B", 1},
+			Unit{"kB", 1'000},
+			Unit{"MB", 1'000'000},
+			Unit{"GB", 1'000'000'000},
+			Unit{"TB", 1'000'000'000'000},
+			Unit{"K", std::uint64_t{1} << 10},
+			Unit{"KiB", std::uint64_t{1} << 10},
+			Unit{"M", std::uint64_t{1} << 20},
+			Unit{"MiB", std::uint64_t{1} << 20},
+			Unit{"G", std::uint64_t{1} << 30},
+			Unit{"GiB", std::uint64_t{1} << 30},
+			Unit{"T", std::uint64_t{1} << 40},
+			Unit{"TiB", std::uint64_t{1} << 40},
+		};
+
+		auto const split = value.find_first_not_of(".0123456789");
+		auto const count = value.substr(0, split);
+		auto const suffix = split == std::string_view::npos ? std::string_view{} : value.substr(split);
+		auto const* unit = std::ranges::find(units_v, suffix, &Unit::suffix);
+		if (unit == units_v.end()) { return false; }
+
+		if (count.find('.') == std::string_view::npos) {
+			auto integral = std::uint64_t{};
+			if (!parse_number(count, integral) || integral > std::numeric_limits<std::uint64_t>::max() / unit->scale) { return false; }
+			out.bytes = integral * unit->scale;
+			return true;
+		}
+
+		auto fractional = double{};
+		if (!parse_number(count, fractional)) { return false; }
+		auto const bytes = fractional * static_cast<double>(unit->scale);
+		if (bytes >= static_cast<double>(std::numeric_limits<std::uint64_t>::max())) { return false; }
+		out.bytes = static_cast<std::uint64_t>(bytes + 0.5);
+		return true;
+	}
+
+	friend auto cliq_to_string(ByteSize const& size) -> std::string {
+		static constexpr auto suffixes_v = std::array<std::string_view, 4>{"TiB", "GiB", "MiB", "KiB"};
+		for (auto i = std::size_t{}; i < suffixes_v.size(); ++i) {
+			auto const scale = std::uint64_t{1} << (10 * (suffixes_v.size() - i));
+			if (size.bytes != 0 && size.bytes % scale == 0) { return std::format("{}{}", size.bytes / scale, suffixes_v[i]); }
+		}
+		return std::format("{}B", size.bytes);
+	}
+};
+} // namespace cliq
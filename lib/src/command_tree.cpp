@@ -0,0 +1,22 @@
+#include <command_tree.hpp>
+#include <algorithm>
+
+namespace cliq {
+CommandTree::CommandTree(std::span<Arg const> args, std::pmr::memory_resource& resource, ParamCommand const* command,
+						 std::span<ParamOption const* const> inherited)
+	: command(command), lookup(args, resource, inherited), children(&resource),
+	  cache{.help = std::pmr::string{&resource}, .usage = std::pmr::string{&resource}} {
+	for (auto const& arg : args) {
+		auto const* cmd = std::get_if<ParamCommand>(&arg.get_param());
+		if (cmd == nullptr || lookup.find_command(cmd->name) != cmd) { continue; }
+		children.emplace_back(cmd->args, resource, cmd, lookup.get_globals());
+	}
+	std::ranges::sort(children, {}, [](CommandTree const& tree) { return tree.command->name; });
+}
+
+auto CommandTree::find_child(std::string_view const name) const -> CommandTree const* {
+	auto const it = std::ranges::lower_bound(children, name, {}, [](CommandTree const& tree) { return tree.command->name; });
+	if (it == children.end() || it->command->name != name) { return nullptr; }
+	return &*it;
+}
+} // namespace cliq
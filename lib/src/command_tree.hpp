@@ -0,0 +1,29 @@
+#pragma once
+#include <lookup.hpp>
+#include <string>
+
+namespace cliq {
+/// \brief Lookups for an arg span and, recursively, for each of its commands; built once and reused across parses.
+struct CommandTree {
+	/// \param inherited Global options of the parent tree's lookup, merged into this tree's lookup (and passed on to its children).
+	explicit CommandTree(std::span<Arg const> args, std::pmr::memory_resource& resource, ParamCommand const* command = nullptr,
+						 std::span<ParamOption const* const> inherited = {});
+
+	/// \returns Child tree for the command named name, if any.
+	[[nodiscard]] auto find_child(std::string_view name) const -> CommandTree const*;
+
+	/// \brief Command this tree was built for (null for the root).
+	ParamCommand const* command{};
+	Lookup lookup;
+	/// \brief Sorted by command name; the first of any duplicates wins.
+	std::pmr::vector<CommandTree> children;
+
+	/// \brief Rendered --help / --usage text (including trailing newline), empty until first requested.
+	/// Only rendered while this tree's outputs hold their initial values, so default values stay accurate.
+	struct Cache {
+		std::pmr::string help;
+		std::pmr::string usage;
+	};
+	mutable Cache cache;
+};
+} // namespace cliq
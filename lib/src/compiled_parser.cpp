@@ -0,0 +1,62 @@
+#include <cliq/compiled_parser.hpp>
+#include <parser.hpp>
+#include <any>
+#include <vector>
+
+namespace cliq {
+namespace {
+struct Saved {
+	Restore restore{};
+	void* data{};
+	std::any value{};
+};
+
+void save_outputs(std::vector<Saved>& out, std::span<Arg const> args) {
+	for (auto const& arg : args) {
+		if (auto const* option = std::get_if<ParamOption>(&arg.get_param())) {
+			out.push_back(Saved{.restore = option->binding.reset->restore, .data = option->data, .value = option->snapshot()});
+		} else if (auto const* positional = std::get_if<ParamPositional>(&arg.get_param())) {
+			out.push_back(Saved{.restore = positional->binding.reset->restore, .data = positional->data, .value = positional->snapshot()});
+		} else if (auto const* command = std::get_if<ParamCommand>(&arg.get_param())) {
+			save_outputs(out, command->args);
+		}
+	}
+}
+} // namespace
+
+struct CompiledParser::Impl {
+	explicit Impl(AppInfo const& info, std::span<Arg const> args, std::string_view const exe_name, ParseConfig const& config)
+		: info(info), exe_name(exe_name), config(config), tree(args, config.get_resource()) {
+		save_outputs(saved, args);
+	}
+
+	AppInfo info;
+	std::string_view exe_name;
+	ParseConfig config;
+	CommandTree tree;
+	std::vector<Saved> saved{};
+};
+
+CompiledParser::CompiledParser(AppInfo const& info, std::span<Arg const> args, std::string_view const exe_name, ParseConfig const& config)
+	: m_impl(std::make_unique<Impl>(info, args, exe_name, config)) {}
+
+CompiledParser::CompiledParser(CompiledParser&&) noexcept = default;
+auto CompiledParser::operator=(CompiledParser&&) noexcept -> CompiledParser& = default;
+CompiledParser::~CompiledParser() = default;
+
+auto CompiledParser::parse(std::span<char const* const> cli_args) -> Result {
+	reset();
+	auto parser = Parser{m_impl->info, m_impl->exe_name, cli_args, m_impl->config};
+	return parser.parse(m_impl->tree);
+}
+
+auto CompiledParser::parse_line(std::span<char> line) -> Result {
+	reset();
+	auto parser = Parser{m_impl->info, m_impl->exe_name, Scanner{Tokenizer{line}}, m_impl->config};
+	return parser.parse(m_impl->tree);
+}
+
+void CompiledParser::reset() {
+	for (auto const& saved : m_impl->saved) { saved.restore(saved.data, saved.value); }
+}
+} // namespace cliq
@@ -0,0 +1,357 @@
+#include <completion.hpp>
+#include <token.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <utility>
+
+namespace cliq {
+namespace {
+using Out = std::back_insert_iterator<std::pmr::string>;
+
+struct Builtin {
+	std::string_view word{};
+	std::string_view help_text{};
+};
+
+constexpr auto builtins_v = std::array{
+	Builtin{.word = "help", .help_text = "display this help and exit"},
+	Builtin{.word = "usage", .help_text = "print usage and exit"},
+	Builtin{.word = "version", .help_text = "print version text and exit"},
+	Builtin{.word = "completions", .help_text = "print shell completion script and exit"},
+};
+
+/// \brief Shell function name for exe: non-alphanumeric characters are replaced with '_'.
+void append_function_name(Out out, std::string_view const exe) {
+	std::format_to(out, "_cliq_");
+	for (auto const c : exe) { *out++ = (is_alpha(c) || (c >= '0' && c <= '9')) ? c : '_'; }
+}
+
+/// \brief Single-quoted for POSIX shells: embedded quotes become '\''.
+void append_quoted(Out out, std::string_view const text, std::string_view const prefix = {}) {
+	std::format_to(out, "'{}", prefix);
+	for (auto const c : text) {
+		if (c == '\'') {
+			std::format_to(out, "'\\''");
+		} else {
+			*out++ = c;
+		}
+	}
+	*out++ = '\'';
+}
+
+/// \brief Single-quoted for fish: embedded quotes and backslashes are escaped.
+void append_fish_quoted(Out out, std::string_view const text) {
+	*out++ = '\'';
+	for (auto const c : text) {
+		if (c == '\'' || c == '\\') { *out++ = '\\'; }
+		*out++ = c;
+	}
+	*out++ = '\'';
+}
+
+/// \brief Single-quoted for fish, then escaped again to sit inside another single-quoted word (eg a -n condition).
+void append_fish_nested_quoted(Out out, std::string_view const text) {
+	auto const put = [&out](char const c) {
+		if (c == '\'' || c == '\\') { *out++ = '\\'; }
+		*out++ = c;
+	};
+	put('\'');
+	for (auto const c : text) {
+		if (c == '\'' || c == '\\') { put('\\'); }
+		put(c);
+	}
+	put('\'');
+}
+
+[[nodiscard]] auto has_commands(std::span<Arg const> args) -> bool {
+	return std::ranges::any_of(args, [](Arg const& arg) { return std::holds_alternative<ParamCommand>(arg.get_param()); });
+}
+
+/// \brief Which options of args to include in a word list.
+enum class Scope : std::int8_t { All, Local, Global };
+
+/// \brief Space separated, individually quoted option keys and command names of args (array elements in bash and zsh).
+/// Commands are skipped in Scope::Global.
+void append_words(Out out, std::span<Arg const> args, Scope const scope = Scope::All) {
+	for (auto const& arg : args) {
+		if (auto const* option = std::get_if<ParamOption>(&arg.get_param())) {
+			if ((scope == Scope::Local && option->global) || (scope == Scope::Global && !option->global)) { continue; }
+			if (!option->word.empty()) {
+				*out++ = ' ';
+				append_quoted(out, option->word, "--");
+			}
+			if (option->letter != '\0') {
+				*out++ = ' ';
+				append_quoted(out, {&option->letter, 1}, "-");
+			}
+		} else if (auto const* command = std::get_if<ParamCommand>(&arg.get_param()); command != nullptr && scope != Scope::Global) {
+			*out++ = ' ';
+			append_quoted(out, command->name);
+		}
+	}
+}
+
+/// \brief Call func(path, command) for every command in args and, depth first, their nested commands.
+/// path is the names of the command and its parents, each preceded by '/' (the root's path is empty).
+template <typename Func>
+void for_each_command(std::span<Arg const> args, std::pmr::string& path, Func const& func) {
+	for (auto const& arg : args) {
+		auto const* command = std::get_if<ParamCommand>(&arg.get_param());
+		if (command == nullptr) { continue; }
+		auto const size = path.size();
+		path += '/';
+		path += command->name;
+		func(std::string_view{path}, *command);
+		for_each_command(command->args, path, func);
+		path.resize(size);
+	}
+}
+
+/// \brief Case pattern matching the path of any (nested) command in args.
+void append_path_pattern(Out out, std::span<Arg const> args, std::pmr::string& path) {
+	auto first = true;
+	for_each_command(args, path, [&](std::string_view const command_path, ParamCommand const& /*command*/) {
+		if (!std::exchange(first, false)) { *out++ = '|'; }
+		append_quoted(out, command_path);
+	});
+}
+
+void append_bash(Out out, std::string_view const exe, std::span<Arg const> args, std::pmr::string& path) {
+	std::format_to(out, "# bash completion for {}\n", exe);
+	append_function_name(out, exe);
+	std::format_to(out, "() {{\n\tlocal cur=\"${{COMP_WORDS[COMP_CWORD]}}\" cmd=\"\" i\n");
+	if (has_commands(args)) {
+		std::format_to(out, "\tfor ((i = 1; i < COMP_CWORD; ++i)); do\n\t\tcase \"$cmd/${{COMP_WORDS[i]}}\" in\n\t\t");
+		append_path_pattern(out, args, path);
+		std::format_to(out, ") cmd=\"$cmd/${{COMP_WORDS[i]}}\" ;;\n\t\tesac\n\tdone\n");
+	}
+
+	// global options of the root are offered in every command.
+	std::format_to(out, "\tlocal -a words=(--help --usage --version --completions");
+	append_words(out, args, Scope::Global);
+	std::format_to(out, ")\n\tcase \"$cmd\" in\n");
+	for_each_command(args, path, [out](std::string_view const command_path, ParamCommand const& command) {
+		std::format_to(out, "\t");
+		append_quoted(out, command_path);
+		std::format_to(out, ") words+=(");
+		append_words(out, command.args);
+		std::format_to(out, ") ;;\n");
+	});
+	std::format_to(out, "\t*) words+=(");
+	append_words(out, args, Scope::Local);
+	std::format_to(out, ") ;;\n\tesac\n");
+
+	std::format_to(out, "\tif [[ \"${{COMP_WORDS[COMP_CWORD-1]}}\" == --completions ]]; then words=(bash zsh fish); fi\n");
+	std::format_to(out, "\tCOMPREPLY=($(compgen -W \"${{words[*]}}\" -- \"$cur\"))\n}}\ncomplete -o default -F ");
+	append_function_name(out, exe);
+	std::format_to(out, " {}\n", exe);
+}
+
+void append_zsh(Out out, std::string_view const exe, std::span<Arg const> args, std::pmr::string& path) {
+	std::format_to(out, "#compdef {}\n", exe);
+	append_function_name(out, exe);
+	std::format_to(out, "() {{\n\tlocal cmd=\"\" w\n\tlocal -a matches=(--help --usage --version --completions");
+	append_words(out, args, Scope::Global);
+	std::format_to(out, ")\n");
+	if (has_commands(args)) {
+		std::format_to(out, "\tfor w in ${{words[2,CURRENT-1]}}; do\n\t\tcase \"$cmd/$w\" in\n\t\t(");
+		append_path_pattern(out, args, path);
+		std::format_to(out, ") cmd=\"$cmd/$w\" ;;\n\t\tesac\n\tdone\n");
+	}
+	std::format_to(out, "\tcase \"$cmd\" in\n");
+	for_each_command(args, path, [out](std::string_view const command_path, ParamCommand const& command) {
+		std::format_to(out, "\t(");
+		append_quoted(out, command_path);
+		std::format_to(out, ") matches+=(");
+		append_words(out, command.args);
+		std::format_to(out, ") ;;\n");
+	});
+	std::format_to(out, "\t(*) matches+=(");
+	append_words(out, args, Scope::Local);
+	std::format_to(out, ") ;;\n\tesac\n");
+
+	std::format_to(out, "\tif [[ \"${{words[CURRENT-1]}}\" == --completions ]]; then matches=(bash zsh fish); fi\n");
+	std::format_to(out, "\tcompadd -a matches\n\t_files\n}}\n");
+	// loaded from fpath: complete now; sourced: register for exe.
+	std::format_to(out, "if [[ \"${{zsh_eval_context[-1]}}\" == loadautofunc ]]; then\n\t");
+	append_function_name(out, exe);
+	std::format_to(out, " \"$@\"\nelse\n\tcompdef ");
+	append_function_name(out, exe);
+	std::format_to(out, " {}\nfi\n", exe);
+}
+
+/// \brief Condition: the command line so far has entered the command at path.
+void append_fish_condition(Out out, std::string_view const exe, std::string_view const path) {
+	std::format_to(out, " -n '_");
+	append_function_name(out, exe);
+	std::format_to(out, "_at ");
+	append_fish_nested_quoted(out, path);
+	*out++ = '\'';
+}
+
+/// \brief Options of args, offered once the command at path (if any) is entered.
+/// Global options of the root (empty path) are offered in every command.
+void append_fish_options(Out out, std::string_view const exe, std::span<Arg const> args, std::string_view const path, bool const conditional) {
+	for (auto const& arg : args) {
+		auto const* option = std::get_if<ParamOption>(&arg.get_param());
+		if (option == nullptr) { continue; }
+		std::format_to(out, "complete -c {}", exe);
+		if (conditional && !(option->global && path.empty())) { append_fish_condition(out, exe, path); }
+		if (option->letter != '\0') { std::format_to(out, " -s {}", option->letter); }
+		if (!option->word.empty()) {
+			std::format_to(out, " -l ");
+			append_fish_quoted(out, option->word);
+		}
+		if (!option->is_flag) { std::format_to(out, " -r"); }
+		if (!option->help_text.empty()) {
+			std::format_to(out, " -d ");
+			append_fish_quoted(out, option->help_text);
+		}
+		*out++ = '\n';
+	}
+}
+
+void append_fish(Out out, std::string_view const exe, std::span<Arg const> args, std::pmr::string& path) {
+	std::format_to(out, "# fish completion for {}\n", exe);
+	auto const conditional = has_commands(args);
+	if (conditional) {
+		// succeeds if the words before the cursor enter exactly the command at path $argv[1].
+		std::format_to(out, "function _");
+		append_function_name(out, exe);
+		std::format_to(out, "_at\n\tset -l words (commandline -opc)\n\tset -e words[1]\n\tset -l path ''\n\tfor w in $words\n");
+		std::format_to(out, "\t\tswitch \"$path/$w\"\n\t\t\tcase");
+		for_each_command(args, path, [out](std::string_view const command_path, ParamCommand const& /*command*/) {
+			*out++ = ' ';
+			append_quoted(out, command_path);
+		});
+		std::format_to(out, "\n\t\t\t\tset path \"$path/$w\"\n\t\tend\n\tend\n\ttest \"$path\" = \"$argv[1]\"\nend\n");
+	}
+
+	for (auto const& builtin : builtins_v) {
+		std::format_to(out, "complete -c {} -l {}", exe, builtin.word);
+		if (builtin.word == "completions") { std::format_to(out, " -x -a 'bash zsh fish'"); }
+		std::format_to(out, " -d '{}'\n", builtin.help_text);
+	}
+
+	append_fish_options(out, exe, args, {}, conditional);
+
+	for_each_command(args, path, [out, exe](std::string_view const command_path, ParamCommand const& command) {
+		std::format_to(out, "complete -c {}", exe);
+		append_fish_condition(out, exe, command_path.substr(0, command_path.rfind('/')));
+		std::format_to(out, " -f -a ");
+		append_fish_quoted(out, command.name);
+		if (!command.help_text.empty()) {
+			std::format_to(out, " -d ");
+			append_fish_quoted(out, command.help_text);
+		}
+		*out++ = '\n';
+		append_fish_options(out, exe, command.args, command_path, true);
+	});
+}
+
+/// \returns true if the option token (without an attached value) expects the next word as its value.
+auto takes_value(Lookup const& lookup, Token const& token) -> bool {
+	if (token.value.empty() || token.value.find('=') != std::string_view::npos) { return false; }
+	if (token.option_type == OptionType::Letters) {
+		auto const* option = lookup.find_option(token.value.back());
+		return option != nullptr && !option->is_flag;
+	}
+	auto const matches = lookup.match_option(token.value);
+	return !matches.empty() && matches.front().key == matches.back().key && !matches.front().param->is_flag;
+}
+
+void append_option_matches(Out out, Lookup const& lookup, std::string_view const prefix) {
+	auto previous = std::string_view{};
+	for (auto const& entry : lookup.find_options_with_prefix(prefix)) {
+		if (std::exchange(previous, entry.key) == entry.key) { continue; }
+		std::format_to(out, "--{}\n", entry.key);
+	}
+	for (auto const& builtin : builtins_v) {
+		if (builtin.word.starts_with(prefix)) { std::format_to(out, "--{}\n", builtin.word); }
+	}
+}
+
+void append_letter_matches(Out out, Lookup const& lookup) {
+	auto const append_letter = [out, &lookup](ParamOption const& option) {
+		if (option.letter == '\0' || lookup.find_option(option.letter) != &option) { return; }
+		std::format_to(out, "-{}\n", option.letter);
+	};
+	for (auto const& arg : lookup.get_args()) {
+		if (auto const* option = std::get_if<ParamOption>(&arg.get_param())) { append_letter(*option); }
+	}
+	for (auto const* option : lookup.get_inherited()) { append_letter(*option); }
+}
+
+void append_command_matches(Out out, Lookup const& lookup, std::string_view const prefix) {
+	auto previous = std::string_view{};
+	for (auto const& entry : lookup.find_commands_with_prefix(prefix)) {
+		if (std::exchange(previous, entry.key) == entry.key) { continue; }
+		std::format_to(out, "{}\n", entry.key);
+	}
+}
+} // namespace
+
+auto to_shell(std::string_view const name) -> std::optional<Shell> {
+	if (name == "bash") { return Shell::Bash; }
+	if (name == "zsh") { return Shell::Zsh; }
+	if (name == "fish") { return Shell::Fish; }
+	return {};
+}
+
+auto format_completions(Shell const shell, std::string_view const exe, std::span<Arg const> args, std::pmr::memory_resource& resource)
+	-> std::pmr::string {
+	auto ret = std::pmr::string{&resource};
+	auto path = std::pmr::string{&resource};
+	auto const out = std::back_inserter(ret);
+	switch (shell) {
+	case Shell::Bash: append_bash(out, exe, args, path); break;
+	case Shell::Zsh: append_zsh(out, exe, args, path); break;
+	case Shell::Fish: append_fish(out, exe, args, path); break;
+	default: std::unreachable(); break;
+	}
+	return ret;
+}
+
+auto format_matches(CommandTree const& tree, std::span<std::string_view const> words, std::pmr::memory_resource& resource) -> std::pmr::string {
+	auto ret = std::pmr::string{&resource};
+	if (words.empty()) { return ret; }
+
+	// replay the preceding words through the lookups: only command selection and option values matter here.
+	auto const* current = &tree;
+	auto force_args = false;
+	auto skip_value = false;
+	for (auto const word : words.first(words.size() - 1)) {
+		if (std::exchange(skip_value, false) || force_args) { continue; }
+		auto const token = to_token(word);
+		switch (token.token_type) {
+		case TokenType::ForceArgs: force_args = true; break;
+		case TokenType::Option: skip_value = takes_value(current->lookup, token); break;
+		case TokenType::Argument:
+			if (current->lookup.has_commands()) {
+				current = current->find_child(word);
+				if (current == nullptr) { return ret; }
+			}
+			break;
+		default: break;
+		}
+	}
+	// values and positionals are left to the shell.
+	if (force_args || skip_value) { return ret; }
+
+	auto const out = std::back_inserter(ret);
+	auto const word = words.back();
+	auto const& lookup = current->lookup;
+	if (word.starts_with("--")) {
+		if (word.find('=') == std::string_view::npos) { append_option_matches(out, lookup, word.substr(2)); }
+	} else if (word == "-") {
+		append_letter_matches(out, lookup);
+		append_option_matches(out, lookup, {});
+	} else if (!word.starts_with('-') && lookup.has_commands()) {
+		append_command_matches(out, lookup, word);
+	}
+	return ret;
+}
+} // namespace cliq
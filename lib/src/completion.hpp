@@ -0,0 +1,21 @@
+#pragma once
+#include <cliq/arg.hpp>
+#include <command_tree.hpp>
+#include <memory_resource>
+#include <optional>
+#include <string>
+
+namespace cliq {
+enum class Shell : std::int8_t { Bash, Zsh, Fish };
+
+[[nodiscard]] auto to_shell(std::string_view name) -> std::optional<Shell>;
+
+/// \brief Format a static completion script for exe, covering the options and commands of args.
+[[nodiscard]] auto format_completions(Shell shell, std::string_view exe, std::span<Arg const> args,
+									  std::pmr::memory_resource& resource = *std::pmr::get_default_resource()) -> std::pmr::string;
+
+/// \brief Format completions (one per line) for the last of words, given the preceding ones.
+/// \param words Command line words after the executable name; the last one is the (possibly empty) word being completed.
+[[nodiscard]] auto format_matches(CommandTree const& tree, std::span<std::string_view const> words,
+								  std::pmr::memory_resource& resource = *std::pmr::get_default_resource()) -> std::pmr::string;
+} // namespace cliq
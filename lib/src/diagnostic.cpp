@@ -0,0 +1,81 @@
+#include <diagnostic.hpp>
+#include <format>
+#include <iterator>
+
+namespace cliq {
+namespace {
+using Out = std::back_insert_iterator<std::pmr::string>;
+
+/// \returns false if the message should not be followed by a pointer to --help.
+auto append_message(Out out, Diagnostic const& d, std::span<std::string_view const> possibilities) -> bool {
+	auto const is_letter = d.input.size() == 1;
+	switch (d.kind) {
+	case DiagnosticKind::InvalidValue: std::format_to(out, "invalid {}: '{}'\n", d.input, d.value); return false;
+	case DiagnosticKind::InvalidOption: std::format_to(out, "invalid option -- '{}'\n", d.input); break;
+	case DiagnosticKind::UnrecognizedOption:
+		std::format_to(out, "unrecognized option '--{}'\n", d.input);
+		if (!d.candidates[0].empty()) { std::format_to(out, "Did you mean '--{}'?\n", d.candidates[0]); }
+		break;
+	case DiagnosticKind::AmbiguousOption:
+		if (possibilities.empty()) {
+			std::format_to(out, "option '--{}' is ambiguous; possibilities include '--{}' '--{}'\n", d.input, d.candidates[0], d.candidates[1]);
+			break;
+		}
+		std::format_to(out, "option '--{}' is ambiguous; possibilities:", d.input);
+		for (auto const possibility : possibilities) { std::format_to(out, " '--{}'", possibility); }
+		std::format_to(out, "\n");
+		break;
+	case DiagnosticKind::UnrecognizedCommand:
+		std::format_to(out, "unrecognized command '{}'\n", d.input);
+		if (!d.candidates[0].empty()) { std::format_to(out, "Did you mean '{}'?\n", d.candidates[0]); }
+		break;
+	case DiagnosticKind::ExtraneousArgument: std::format_to(out, "extraneous argument '{}'\n", d.input); break;
+	case DiagnosticKind::OptionRequiresArgument:
+		if (is_letter) {
+			std::format_to(out, "option requires an argument -- '{}'\n", d.input);
+		} else {
+			std::format_to(out, "option '{}' requires an argument\n", d.input);
+		}
+		break;
+	case DiagnosticKind::OptionIsFlag:
+		if (is_letter) {
+			std::format_to(out, "option does not take an argument -- '{}'\n", d.input);
+		} else {
+			std::format_to(out, "option '{}' does not take an argument\n", d.input);
+		}
+		break;
+	case DiagnosticKind::UnterminatedQuote: std::format_to(out, "unterminated quote\n"); break;
+	case DiagnosticKind::UnreadableResponseFile: std::format_to(out, "cannot read response file '{}'\n", d.input); return false;
+	case DiagnosticKind::InvalidEnvironment: std::format_to(out, "invalid environment variable {}: '{}'\n", d.input, d.value); return false;
+	case DiagnosticKind::InvalidConfig: std::format_to(out, "invalid config key {}: '{}'\n", d.input, d.value); return false;
+	case DiagnosticKind::MissingArgument: std::format_to(out, "missing {}\n", d.input); break;
+	default: break;
+	}
+	return true;
+}
+
+void append_exe_cmd(Out out, Diagnostic const& d) {
+	std::format_to(out, "{}", d.exe_name);
+	if (!d.command.empty()) { std::format_to(out, " {}", d.command); }
+}
+} // namespace
+
+auto format_diagnostic(Diagnostic const& diagnostic, std::pmr::memory_resource& resource) -> std::pmr::string {
+	return format_diagnostic(diagnostic, {}, resource);
+}
+
+auto format_diagnostic(Diagnostic const& diagnostic, std::span<std::string_view const> const possibilities, std::pmr::memory_resource& resource)
+	-> std::pmr::string {
+	auto ret = std::pmr::string{&resource};
+	if (diagnostic.kind == DiagnosticKind::None) { return ret; }
+	auto const out = std::back_inserter(ret);
+	append_exe_cmd(out, diagnostic);
+	std::format_to(out, ": ");
+	if (append_message(out, diagnostic, possibilities)) {
+		std::format_to(out, "Try '");
+		append_exe_cmd(out, diagnostic);
+		std::format_to(out, " --help' for more information.\n");
+	}
+	return ret;
+}
+} // namespace cliq
@@ -0,0 +1,10 @@
+#pragma once
+#include <cliq/diagnostic.hpp>
+#include <span>
+
+namespace cliq {
+/// \brief Format a diagnostic like format_diagnostic(diagnostic, resource), but list all of possibilities
+/// (instead of the first two candidates) for an AmbiguousOption, like getopt_long.
+[[nodiscard]] auto format_diagnostic(Diagnostic const& diagnostic, std::span<std::string_view const> possibilities, std::pmr::memory_resource& resource)
+	-> std::pmr::string;
+} // namespace cliq
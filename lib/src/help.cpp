@@ -0,0 +1,154 @@
+#include <help.hpp>
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <utility>
+
+namespace cliq {
+namespace {
+using Out = std::back_insert_iterator<std::pmr::string>;
+
+struct PrintParam {
+	std::pmr::string& out_str;
+	bool* has_commands{};
+
+	Out out{std::back_inserter(out_str)};
+
+	void operator()(ParamOption const& o) const {
+		std::format_to(out, " [");
+		if (o.letter != '\0') {
+			std::format_to(out, "-{}", o.letter);
+			if (!o.word.empty()) { std::format_to(out, "|"); }
+		}
+		if (!o.word.empty()) { std::format_to(out, "--{}", o.word); }
+		if (!o.is_flag) {
+			std::format_to(out, "(=");
+			o.append_to(out_str);
+			std::format_to(out, ")");
+		}
+		std::format_to(out, "]");
+	}
+
+	void operator()(ParamPositional const& p) const {
+		std::string_view const wrap = p.is_required() ? "<>" : "[]";
+		std::format_to(out, " {}{}", wrap[0], p.name);
+		if (!p.is_list && !p.is_required()) {
+			std::format_to(out, "(=");
+			p.append_to(out_str);
+			std::format_to(out, ")");
+		}
+		std::format_to(out, "{}", wrap[1]);
+	}
+
+	void operator()(ParamCommand const& /*c*/) const {
+		if (has_commands != nullptr) { *has_commands = true; }
+	}
+};
+
+void append_exe_cmd(Out out, std::string_view const exe, std::string_view const cmd) {
+	std::format_to(out, "{}", exe);
+	if (!cmd.empty()) { std::format_to(out, " {}", cmd); }
+}
+
+void append_positionals(std::pmr::string& out, std::span<Arg const> args) {
+	for (auto const& arg : args) {
+		if (auto const* pos = std::get_if<ParamPositional>(&arg.get_param())) { PrintParam{out}(*pos); }
+	}
+}
+
+void append_option_key(Out out, std::size_t const width, ParamOption const& option) {
+	auto length = std::size_t{4};
+	if (option.letter == '\0') {
+		std::format_to(out, "    ");
+	} else {
+		std::format_to(out, "-{}", option.letter);
+		length = 2;
+		if (!option.word.empty()) {
+			std::format_to(out, ", ");
+			length += 2;
+		}
+	}
+	if (!option.word.empty()) {
+		std::format_to(out, "--{}", option.word);
+		length += option.word.size() + 2;
+	}
+	if (length < width) { std::format_to(out, "{:{}}", "", width - length); }
+}
+
+void append_option_list(Out out, std::size_t const width, Lookup const& lookup) {
+	std::format_to(out, "\nOPTIONS\n");
+	auto const print_option = [out, width](std::string_view const key, std::string_view const help_text) {
+		std::format_to(out, "  {:<{}}{}\n", key, width, help_text);
+	};
+	auto const print_param = [out, width](ParamOption const& option) {
+		std::format_to(out, "  ");
+		append_option_key(out, width, option);
+		std::format_to(out, "{}\n", option.help_text);
+	};
+	for (auto const& arg : lookup.get_args()) {
+		if (auto const* option = std::get_if<ParamOption>(&arg.get_param())) { print_param(*option); }
+	}
+	for (auto const* option : lookup.get_inherited()) { print_param(*option); }
+	print_option("    --help", "display this help and exit");
+	print_option("    --usage", "print usage and exit");
+	print_option("    --version", "print version text and exit");
+	print_option("    --completions", "print shell completion script (bash|zsh|fish) and exit");
+}
+
+void append_command_list(Out out, std::size_t const width, std::span<Arg const> args) {
+	std::format_to(out, "\nCOMMANDS\n");
+	for (auto const& arg : args) {
+		auto const* cmd = std::get_if<ParamCommand>(&arg.get_param());
+		if (cmd == nullptr) { continue; }
+		std::format_to(out, "  {:<{}}{}\n", cmd->name, width, cmd->help_text);
+	}
+}
+} // namespace
+
+auto format_help(AppInfo const& info, std::string_view const exe, std::string_view const cmd, Lookup const& lookup,
+				 std::pmr::memory_resource& resource) -> std::pmr::string {
+	auto ret = std::pmr::string{&resource};
+	auto const out = std::back_inserter(ret);
+	if (!info.help_text.empty()) { std::format_to(out, "{}\n", info.help_text); }
+
+	auto const args = lookup.get_args();
+	auto const& layout = lookup.get_help_layout();
+	auto const has_commands = layout.commands_width > 0;
+
+	std::format_to(out, "Usage:\n  ");
+	append_exe_cmd(out, exe, cmd);
+
+	if (layout.has_options) { std::format_to(out, " [OPTION...]"); }
+	if (has_commands) {
+		std::format_to(out, " <COMMAND> [COMMAND_ARGS...]");
+	} else if (layout.has_positionals) {
+		append_positionals(ret, args);
+	}
+	std::format_to(out, "\n  ");
+	append_exe_cmd(out, exe, cmd);
+	if (has_commands) { std::format_to(out, " [COMMAND]"); }
+	std::format_to(out, " [--help|--usage|--version]\n");
+
+	append_option_list(out, layout.options_width + 4, lookup);
+
+	if (has_commands) { append_command_list(out, layout.commands_width + 4, args); }
+
+	if (!info.epilogue.empty()) { std::format_to(out, "\n{}\n", info.epilogue); }
+
+	return ret;
+}
+
+auto format_usage(std::string_view const exe, std::string_view const cmd, std::span<Arg const> args, std::pmr::memory_resource& resource)
+	-> std::pmr::string {
+	auto ret = std::pmr::string{&resource};
+	auto const out = std::back_inserter(ret);
+	append_exe_cmd(out, exe, cmd);
+	auto has_commands = false;
+	auto const print_param = PrintParam{ret, &has_commands};
+	for (auto const& arg : args) { std::visit(print_param, arg.get_param()); }
+
+	if (has_commands) { std::format_to(out, " <COMMAND> [COMMAND_ARGS...]"); }
+
+	return ret;
+}
+} // namespace cliq
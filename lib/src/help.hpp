@@ -0,0 +1,14 @@
+#pragma once
+#include <cliq/app_info.hpp>
+#include <cliq/arg.hpp>
+#include <lookup.hpp>
+#include <memory_resource>
+#include <string>
+
+namespace cliq {
+/// \brief Format help text for the args of lookup, using its precomputed layout.
+[[nodiscard]] auto format_help(AppInfo const& info, std::string_view exe, std::string_view cmd, Lookup const& lookup,
+							   std::pmr::memory_resource& resource = *std::pmr::get_default_resource()) -> std::pmr::string;
+[[nodiscard]] auto format_usage(std::string_view exe, std::string_view cmd, std::span<Arg const> args,
+								std::pmr::memory_resource& resource = *std::pmr::get_default_resource()) -> std::pmr::string;
+} // namespace cliq
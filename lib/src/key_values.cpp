@@ -0,0 +1,57 @@
+#include <key_values.hpp>
+#include <cstdlib>
+
+#if !defined(_WIN32)
+extern "C" char** environ; // NOLINT(readability-redundant-declaration)
+#endif
+
+namespace cliq {
+namespace {
+constexpr auto trim(std::string_view text) -> std::string_view {
+	constexpr auto whitespace_v = std::string_view{" \t\r"};
+	auto const first = text.find_first_not_of(whitespace_v);
+	if (first == std::string_view::npos) { return {}; }
+	text = text.substr(first);
+	return text.substr(0, text.find_last_not_of(whitespace_v) + 1);
+}
+} // namespace
+
+auto get_process_environment() -> char const* const* {
+#if defined(_WIN32)
+	return _environ;
+#else
+	return environ;
+#endif
+}
+
+void KeyValues::add_environment(char const* const* environment) {
+	if (environment == nullptr) { return; }
+	for (; *environment != nullptr; ++environment) {
+		auto const entry = std::string_view{*environment};
+		auto const eq = entry.find('=');
+		// Windows has entries like "=C:=C:\path" for per-drive directories.
+		if (eq == std::string_view::npos || eq == 0) { continue; }
+		m_map.try_emplace(entry.substr(0, eq), entry.substr(eq + 1));
+	}
+}
+
+void KeyValues::add_config(std::string_view text) {
+	while (!text.empty()) {
+		auto const eol = text.find('\n');
+		auto const line = trim(text.substr(0, eol));
+		text = eol == std::string_view::npos ? std::string_view{} : text.substr(eol + 1);
+		if (line.empty() || line.starts_with('#')) { continue; }
+		auto const eq = line.find('=');
+		if (eq == std::string_view::npos) { continue; }
+		auto const key = trim(line.substr(0, eq));
+		if (key.empty()) { continue; }
+		m_map.insert_or_assign(key, trim(line.substr(eq + 1)));
+	}
+}
+
+auto KeyValues::find(std::string_view const key) const -> std::optional<std::string_view> {
+	auto const it = m_map.find(key);
+	if (it == m_map.end()) { return {}; }
+	return it->second;
+}
+} // namespace cliq
@@ -0,0 +1,29 @@
+#pragma once
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+namespace cliq {
+/// \brief Null-terminated KEY=VALUE array of the current process.
+[[nodiscard]] auto get_process_environment() -> char const* const*;
+
+/// \brief Hash index of key / value pairs, built once from an environment block or config file text.
+/// Views point into the source, which must outlive this object.
+class KeyValues {
+  public:
+	explicit KeyValues(std::pmr::memory_resource& resource) : m_map(&resource) {}
+
+	/// \brief Index a null-terminated array of KEY=VALUE strings (eg environ). The first of any duplicate keys wins.
+	void add_environment(char const* const* environment);
+	/// \brief Index lines of the form "key = value". Blank lines, lines starting with '#', and lines without '=' are skipped.
+	/// Surrounding whitespace is trimmed from keys and values; the last of any duplicate keys wins.
+	void add_config(std::string_view text);
+
+	[[nodiscard]] auto find(std::string_view key) const -> std::optional<std::string_view>;
+
+  private:
+	std::pmr::unordered_map<std::string_view, std::string_view> m_map;
+};
+} // namespace cliq
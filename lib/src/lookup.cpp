@@ -0,0 +1,108 @@
+#include <lookup.hpp>
+#include <suggest.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace cliq {
+namespace {
+template <typename Type>
+auto by_key(Lookup::Entry<Type> const& a, Lookup::Entry<Type> const& b) -> bool {
+	// params live in one contiguous span, so address order is declaration order.
+	if (a.key == b.key) { return std::less<>{}(a.param, b.param); }
+	return a.key < b.key;
+}
+
+template <typename Type>
+auto find_entry(std::span<Lookup::Entry<Type> const> entries, std::string_view const key) -> Type const* {
+	auto const it = std::ranges::lower_bound(entries, key, {}, &Lookup::Entry<Type>::key);
+	if (it == entries.end() || it->key != key) { return nullptr; }
+	return it->param;
+}
+
+template <typename Type>
+auto find_prefixed(std::span<Lookup::Entry<Type> const> entries, std::string_view const prefix) -> std::span<Lookup::Entry<Type> const> {
+	// keys starting with prefix sort contiguously, right after any that are lexicographically smaller.
+	auto const first = std::ranges::lower_bound(entries, prefix, {}, &Lookup::Entry<Type>::key);
+	auto const last = std::partition_point(first, entries.end(), [prefix](Lookup::Entry<Type> const& entry) { return entry.key.starts_with(prefix); });
+	return {first, last};
+}
+} // namespace
+
+Lookup::Lookup(std::span<Arg const> args, std::pmr::memory_resource& resource, std::span<ParamOption const* const> inherited)
+	: m_args(args), m_words(&resource), m_commands(&resource), m_globals(&resource) {
+	// wide enough for the builtin "    --completions".
+	m_help_layout.options_width = std::string_view{"___--completions"}.size();
+	for (auto const& arg : m_args) {
+		if (auto const* option = std::get_if<ParamOption>(&arg.get_param())) {
+			auto& letter = m_letters[static_cast<unsigned char>(option->letter)];
+			if (option->letter != '\0' && letter == nullptr) { letter = option; }
+			if (!option->word.empty()) { m_words.push_back({option->word, option}); }
+			if (option->global) { m_globals.push_back(option); }
+			m_help_layout.has_options = true;
+			m_help_layout.options_width = std::max(m_help_layout.options_width, option->word.size() + 6);
+		} else if (auto const* command = std::get_if<ParamCommand>(&arg.get_param())) {
+			m_commands.push_back({command->name, command});
+			m_help_layout.commands_width = std::max(m_help_layout.commands_width, command->name.size());
+		} else {
+			m_help_layout.has_positionals = true;
+		}
+	}
+
+	// the first of any duplicate keys wins, matching declaration order.
+	// (not stable_sort: that allocates a temporary buffer outside the memory resource.)
+	std::ranges::sort(m_words, by_key<ParamOption>);
+	std::ranges::sort(m_commands, by_key<ParamCommand>);
+
+	// merge in inherited globals, so nested commands resolve them with the same single lookup as their own options.
+	// any key clash with an option of args shadows the inherited option entirely (and for all further nested commands).
+	m_own_globals = m_globals.size();
+	auto const local_words = std::span<Entry<ParamOption> const>{m_words};
+	for (auto const* option : inherited) {
+		auto& letter = m_letters[static_cast<unsigned char>(option->letter)];
+		if (option->letter != '\0' && letter != nullptr) { continue; }
+		if (!option->word.empty() && find_entry<ParamOption>(local_words, option->word) != nullptr) { continue; }
+		if (option->letter != '\0') { letter = option; }
+		m_globals.push_back(option);
+	}
+	for (auto const* option : get_inherited()) {
+		if (!option->word.empty()) { m_words.push_back({option->word, option}); }
+		m_help_layout.has_options = true;
+		m_help_layout.options_width = std::max(m_help_layout.options_width, option->word.size() + 6);
+	}
+	// inherited words never equal a local one, and equal each other only within one parent span, so by_key still orders them.
+	if (m_globals.size() > m_own_globals) { std::ranges::sort(m_words, by_key<ParamOption>); }
+}
+
+auto Lookup::find_option(std::string_view const word) const -> ParamOption const* { return find_entry<ParamOption>(m_words, word); }
+
+auto Lookup::find_command(std::string_view const name) const -> ParamCommand const* { return find_entry<ParamCommand>(m_commands, name); }
+
+auto Lookup::match_option(std::string_view const word) const -> std::span<Entry<ParamOption> const> {
+	if (word.empty()) { return {}; }
+	auto const ret = find_options_with_prefix(word);
+	if (ret.empty() || ret.front().key != word) { return ret; }
+	// an exact match sorts first, and wins over longer words it is a prefix of.
+	auto const last = std::partition_point(ret.begin(), ret.end(), [word](Entry<ParamOption> const& entry) { return entry.key == word; });
+	return {ret.begin(), last};
+}
+
+auto Lookup::suggest_option(std::string_view const word) const -> std::string_view {
+	auto ret = NearestWord{word};
+	for (auto const& entry : m_words) { ret.add(entry.key); }
+	return ret.get();
+}
+
+auto Lookup::suggest_command(std::string_view const name) const -> std::string_view {
+	auto ret = NearestWord{name};
+	for (auto const& entry : m_commands) { ret.add(entry.key); }
+	return ret.get();
+}
+
+auto Lookup::find_options_with_prefix(std::string_view const prefix) const -> std::span<Entry<ParamOption> const> {
+	return find_prefixed<ParamOption>(m_words, prefix);
+}
+
+auto Lookup::find_commands_with_prefix(std::string_view const prefix) const -> std::span<Entry<ParamCommand> const> {
+	return find_prefixed<ParamCommand>(m_commands, prefix);
+}
+} // namespace cliq
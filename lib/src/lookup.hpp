@@ -0,0 +1,69 @@
+#pragma once
+#include <cliq/arg.hpp>
+#include <array>
+#include <climits>
+#include <memory_resource>
+#include <vector>
+
+namespace cliq {
+/// \brief Column widths and sections of help text for a span of Args.
+struct HelpLayout {
+	std::size_t options_width{};
+	std::size_t commands_width{};
+	bool has_options{};
+	bool has_positionals{};
+};
+
+/// \brief Precomputed index over a span of Args, built once per span.
+class Lookup {
+  public:
+	template <typename Type>
+	struct Entry {
+		std::string_view key{};
+		Type const* param{};
+	};
+
+	Lookup() = default;
+
+	/// \param inherited Global options of parent commands (the parent Lookup's get_globals()), merged into this index.
+	explicit Lookup(std::span<Arg const> args, std::pmr::memory_resource& resource = *std::pmr::get_default_resource(),
+					std::span<ParamOption const* const> inherited = {});
+
+	[[nodiscard]] auto get_args() const -> std::span<Arg const> { return m_args; }
+	[[nodiscard]] auto has_commands() const -> bool { return !m_commands.empty(); }
+	[[nodiscard]] auto get_help_layout() const -> HelpLayout const& { return m_help_layout; }
+	/// \returns Global options of args, followed by the inherited ones not shadowed by them: what nested commands inherit.
+	[[nodiscard]] auto get_globals() const -> std::span<ParamOption const* const> { return m_globals; }
+	/// \returns Inherited global options not shadowed by any option of args.
+	[[nodiscard]] auto get_inherited() const -> std::span<ParamOption const* const> { return std::span{m_globals}.subspan(m_own_globals); }
+
+	[[nodiscard]] auto find_option(char const letter) const -> ParamOption const* { return m_letters[static_cast<unsigned char>(letter)]; }
+	[[nodiscard]] auto find_option(std::string_view word) const -> ParamOption const*;
+	[[nodiscard]] auto find_command(std::string_view name) const -> ParamCommand const*;
+
+	/// \brief Match word exactly, or else as an abbreviation (prefix) of option words.
+	/// \returns Matching entries: none if unrecognized, more than one distinct word if ambiguous.
+	[[nodiscard]] auto match_option(std::string_view word) const -> std::span<Entry<ParamOption> const>;
+
+	/// \returns Entries whose word starts with prefix, sorted by word (duplicates adjacent).
+	[[nodiscard]] auto find_options_with_prefix(std::string_view prefix) const -> std::span<Entry<ParamOption> const>;
+	/// \returns Entries whose name starts with prefix, sorted by name (duplicates adjacent).
+	[[nodiscard]] auto find_commands_with_prefix(std::string_view prefix) const -> std::span<Entry<ParamCommand> const>;
+
+	/// \brief Only called on the error path: scans all option words.
+	/// \returns Closest option word to word, if any is within a small edit distance.
+	[[nodiscard]] auto suggest_option(std::string_view word) const -> std::string_view;
+	/// \brief Only called on the error path: scans all command names.
+	/// \returns Closest command name to name, if any is within a small edit distance.
+	[[nodiscard]] auto suggest_command(std::string_view name) const -> std::string_view;
+
+  private:
+	std::span<Arg const> m_args{};
+	std::array<ParamOption const*, std::size_t(UCHAR_MAX) + 1> m_letters{};
+	std::pmr::vector<Entry<ParamOption>> m_words{};
+	std::pmr::vector<Entry<ParamCommand>> m_commands{};
+	std::pmr::vector<ParamOption const*> m_globals{};
+	std::size_t m_own_globals{};
+	HelpLayout m_help_layout{};
+};
+} // namespace cliq
@@ -1,9 +1,14 @@
 #include <cliq/parse.hpp>
+#include <completion.hpp>
+#include <diagnostic.hpp>
+#include <help.hpp>
 #include <parser.hpp>
+#include <result_key.hpp>
+#include <scanner_source.hpp>
+#include <threaded_batch.hpp>
 #include <algorithm>
-#include <iomanip>
+#include <cstdio>
 #include <print>
-#include <sstream>
 #include <utility>
 
 namespace cliq {
@@ -14,237 +19,74 @@ constexpr auto get_exe_name(std::string_view const arg0) -> std::string_view {
 	return arg0.substr(i + 1);
 }
 
-struct ErrorPrinter {
-	ErrorPrinter(ErrorPrinter const&) = delete;
-	ErrorPrinter(ErrorPrinter&&) = delete;
-	auto operator=(ErrorPrinter const&) = delete;
-	auto operator=(ErrorPrinter&&) = delete;
-
-	explicit ErrorPrinter(std::string_view exe_name, std::string_view cmd_id = {}) : exe_name(exe_name), cmd_name(cmd_id) {
-		str.reserve(400);
-		append_error_prefix();
-	}
-
-	~ErrorPrinter() {
-		if (helpline) { append_helpline(); }
-		std::print(stderr, "{}", str);
-	}
-
-	[[nodiscard]] auto invalid_value(std::string_view const input, std::string_view const value) -> ParseError {
-		helpline = false;
-		std::format_to(std::back_inserter(str), "invalid {}: '{}'\n", input, value);
-		return ParseError::InvalidArgument;
-	}
-
-	[[nodiscard]] auto invalid_option(char const letter) -> ParseError {
-		std::format_to(std::back_inserter(str), "invalid option -- '{}'\n", letter);
-		return ParseError::InvalidOption;
-	}
-
-	[[nodiscard]] auto unrecognized_option(std::string_view const input) -> ParseError {
-		std::format_to(std::back_inserter(str), "unrecognized option '--{}'\n", input);
-		return ParseError::InvalidOption;
-	}
-
-	[[nodiscard]] auto unrecognized_command(std::string_view const input) -> ParseError {
-		std::format_to(std::back_inserter(str), "unrecognized command '{}'\n", input);
-		return ParseError::InvalidCommand;
-	}
-
-	[[nodiscard]] auto extraneous_argument(std::string_view const input) -> ParseError {
-		std::format_to(std::back_inserter(str), "extraneous argument '{}'\n", input);
-		return ParseError::InvalidArgument;
-	}
-
-	[[nodiscard]] auto option_requires_argument(std::string_view const input) -> ParseError {
-		if (input.size() == 1) {
-			std::format_to(std::back_inserter(str), "option requires an argument -- '{}'\n", input);
-		} else {
-			std::format_to(std::back_inserter(str), "option '{}' requires an argument\n", input);
-		}
-		return ParseError::MissingArgument;
-	}
-
-	[[nodiscard]] auto option_is_flag(std::string_view const input) -> ParseError {
-		if (input.size() == 1) {
-			std::format_to(std::back_inserter(str), "option does not take an argument -- '{}'\n", input);
-		} else {
-			std::format_to(std::back_inserter(str), "option '{}' does not take an argument\n", input);
-		}
-		return ParseError::InvalidArgument;
-	}
-
-	[[nodiscard]] auto missing_argument(std::string_view name) -> ParseError {
-		std::format_to(std::back_inserter(str), "missing {}\n", name);
-		return ParseError::MissingArgument;
-	}
-
-	void append_error_prefix() {
-		str += exe_name;
-		if (!cmd_name.empty()) { std::format_to(std::back_inserter(str), " {}", cmd_name); }
-		str += ": ";
-	}
-
-	void append_helpline() {
-		std::format_to(std::back_inserter(str), "Try '{}", exe_name);
-		if (!cmd_name.empty()) { std::format_to(std::back_inserter(str), " {}", cmd_name); }
-		str += " --help' for more information.\n";
+constexpr auto to_parse_error(DiagnosticKind const kind) -> ParseError {
+	switch (kind) {
+	case DiagnosticKind::UnrecognizedCommand: return ParseError::InvalidCommand;
+	case DiagnosticKind::InvalidOption:
+	case DiagnosticKind::UnrecognizedOption: return ParseError::InvalidOption;
+	case DiagnosticKind::AmbiguousOption: return ParseError::AmbiguousOption;
+	case DiagnosticKind::OptionRequiresArgument:
+	case DiagnosticKind::MissingArgument: return ParseError::MissingArgument;
+	default: return ParseError::InvalidArgument;
 	}
-
-	std::string_view exe_name{};
-	std::string_view cmd_name{};
-	bool helpline{true};
-	std::string str;
-};
-
-struct PrintParam {
-	std::ostream& out;
-	bool* has_commands{};
-
-	void operator()(ParamOption const& o) const {
-		out << " [";
-		if (o.letter != '\0') {
-			out << '-' << o.letter;
-			if (!o.word.empty()) { out << '|'; }
-		}
-		if (!o.word.empty()) { out << "--" << o.word; }
-		if (!o.is_flag) { out << "(=" << o.to_string() << ')'; }
-		out << ']';
-	}
-
-	void operator()(ParamPositional const& p) const {
-		std::string_view const wrap = p.is_required() ? "<>" : "[]";
-		out << ' ' << wrap[0] << p.name;
-		if (!p.is_list && !p.is_required()) { out << "(=" << p.to_string() << ")"; }
-		out << wrap[1];
-	}
-
-	void operator()(ParamCommand const& /*c*/) const {
-		if (has_commands != nullptr) { *has_commands = true; }
-	}
-};
-
-auto append_exe_cmd(std::ostream& out, std::string_view const exe, std::string_view const cmd) {
-	out << exe;
-	if (!cmd.empty()) { out << " " << cmd; }
 }
 
-void append_positionals(std::ostream& out, std::span<Arg const> args) {
-	for (auto const& arg : args) {
-		if (auto const* pos = std::get_if<ParamPositional>(&arg.get_param())) { PrintParam{out}(*pos); }
-	}
-}
+void write_stdout(std::string_view const text) { std::fwrite(text.data(), 1, text.size(), stdout); }
+} // namespace
 
-void append_option_list(std::ostream& out, std::size_t const width, std::span<Arg const> args) {
-	out << "\nOPTIONS\n";
-	auto const print_option = [&out, width](std::string_view const key, std::string_view const help_text) {
-		out << "  " << std::setw(int(width)) << key << help_text << "\n";
-	};
-	auto option_key = std::string{};
-	for (auto const& arg : args) {
-		auto const* option = std::get_if<ParamOption>(&arg.get_param());
-		if (option == nullptr) { continue; }
-		option_key.clear();
-		if (option->letter == '\0') {
-			option_key += "    ";
-		} else {
-			option_key += '-';
-			option_key += option->letter;
-			if (!option->word.empty()) { option_key += ", "; }
-		}
-		if (!option->word.empty()) {
-			option_key += "--";
-			option_key += option->word;
-		}
-		print_option(option_key, option->help_text);
-	}
-	print_option("    --help", "display this help and exit");
-	print_option("    --usage", "print usage and exit");
-	print_option("    --version", "print version text and exit");
+auto Parser::parse(std::span<Arg const> args) -> Result {
+	m_tree = m_root_tree = nullptr;
+	m_root_args = args;
+	m_lookup = &m_local.emplace(args, *m_resource);
+	return run();
 }
 
-void append_command_list(std::ostream& out, std::size_t const width, std::span<Arg const> args) {
-	out << "\nCOMMANDS\n" << std::left;
-	for (auto const& arg : args) {
-		auto const* cmd = std::get_if<ParamCommand>(&arg.get_param());
-		if (cmd == nullptr) { continue; }
-		out << "  " << std::setw(int(width)) << cmd->name << cmd->help_text << "\n";
-	}
+auto Parser::parse(CommandTree const& tree) -> Result {
+	m_tree = m_root_tree = &tree;
+	m_root_args = tree.lookup.get_args();
+	m_lookup = &tree.lookup;
+	return run();
 }
 
-void print_help(AppInfo const& info, std::string_view const exe, std::string_view const cmd, std::span<Arg const> args) {
-	auto out = std::ostringstream{};
-	if (!info.help_text.empty()) { out << info.help_text << "\n"; }
-
-	auto has_positionals = false;
-	auto has_options = false;
-	auto options_width = std::string_view{"___--version"}.size();
-	auto commands_width = std::size_t{};
-	for (auto const& arg : args) {
-		switch (arg.get_param().index()) {
-		case 0:
-			has_options = true;
-			options_width = std::max(options_width, std::get<ParamOption>(arg.get_param()).word.size() + 6);
-			break;
-		case 1: has_positionals = true; break;
-		case 2: commands_width = std::max(commands_width, std::get<ParamCommand>(arg.get_param()).name.size()); break;
-		default: std::unreachable(); break;
-		}
-	}
-	auto const has_commands = commands_width > 0;
-
-	out << "Usage:\n  ";
-	append_exe_cmd(out, exe, cmd);
-
-	if (has_options) { out << " [OPTION...]"; }
-	if (has_commands) {
-		out << " <COMMAND> [COMMAND_ARGS...]";
-	} else if (has_positionals) {
-		append_positionals(out, args);
-	}
-	out << "\n  ";
-	append_exe_cmd(out, exe, cmd);
-	if (has_commands) { out << " [COMMAND]"; }
-	out << " [--help|--usage|--version]\n" << std::left;
-
-	append_option_list(out, options_width + 4, args);
-
-	if (has_commands) { append_command_list(out, commands_width + 4, args); }
-
-	if (!info.epilogue.empty()) { out << "\n" << info.epilogue << "\n"; }
-	out << std::right;
-
-	std::println("{}", out.str());
+auto Parser::make_response_files(ParseConfig const& config, std::pmr::memory_resource& resource) -> std::shared_ptr<ResponseFiles> {
+	if (!config.response_files) { return {}; }
+	return std::allocate_shared<ResponseFiles>(std::pmr::polymorphic_allocator<>{&resource}, resource);
 }
 
-void print_usage(std::string_view const exe, std::string_view const cmd, std::span<Arg const> args) {
-	auto out = std::ostringstream{};
-	append_exe_cmd(out, exe, cmd);
-	auto has_commands = false;
-	auto const print_param = PrintParam{out, &has_commands};
-	for (auto const& arg : args) { std::visit(print_param, arg.get_param()); }
-
-	if (has_commands) { out << " <COMMAND> [COMMAND_ARGS...]"; }
-
-	std::println("{}", out.str());
+auto Parser::run() -> Result {
+	auto ret = scan();
+	if (!m_path) { return Result{detail::ResultKey{}, std::move(ret), std::move(m_response_files)}; }
+	m_path->response_files = std::move(m_response_files);
+	auto const names = std::span<std::string_view const>{m_path->names};
+	return Result{detail::ResultKey{}, std::move(ret), std::move(m_path), names};
 }
-} // namespace
 
-auto Parser::parse(std::span<Arg const> args) -> Result {
-	m_args = args;
+auto Parser::scan() -> Result {
 	m_cursor = {};
-	m_has_commands = std::ranges::any_of(m_args, [](Arg const& a) { return std::holds_alternative<ParamCommand>(a.get_param()); });
+	m_path.reset();
+	m_streamed = false;
 
 	auto result = Result{};
 
-	while (m_scanner.next()) {
-		result = parse_next();
+	while (!m_streamed && m_scanner.next()) {
+		result = trace_enabled_v && m_config.tracer != nullptr ? parse_traced() : parse_next();
 		if (result.early_return()) { return result; }
 	}
 
+	// any scan error past a stream's first word is the stream's to report.
+	switch (m_streamed ? ScanError::None : m_scanner.get_error()) {
+	case ScanError::UnterminatedQuote: return fail({.kind = DiagnosticKind::UnterminatedQuote, .index = m_scanner.get_error_index()});
+	case ScanError::UnreadableResponseFile:
+		return fail({.kind = DiagnosticKind::UnreadableResponseFile, .index = m_scanner.get_error_index(), .input = m_scanner.get_error_input()});
+	default: break;
+	}
+
 	result = check_required();
 	if (result.early_return()) { return result; }
 
+	result = resolve_fallbacks();
+	if (result.early_return()) { return result; }
+
 	if (m_cursor.cmd != nullptr) { return m_cursor.cmd->name; }
 
 	return result;
@@ -252,14 +94,61 @@ auto Parser::parse(std::span<Arg const> args) -> Result {
 
 auto Parser::select_command() -> Result {
 	auto const name = m_scanner.get_value();
-	auto const* cmd = find_command(name);
-	if (cmd == nullptr) { return ErrorPrinter{m_exe_name}.unrecognized_command(name); }
+	if (m_tree != nullptr) {
+		auto const* child = m_tree->find_child(name);
+		if (child == nullptr) { return unrecognized_command(name); }
+		m_tree = child;
+		m_lookup = &m_tree->lookup;
+		push_command(*m_tree->command);
+		return {};
+	}
+
+	auto const* cmd = m_lookup->find_command(name);
+	if (cmd == nullptr) { return unrecognized_command(name); }
 
-	m_args = cmd->args;
-	m_cursor = Cursor{.cmd = cmd};
+	// m_lookup is about to be replaced: copy out the globals the command inherits first.
+	auto const inherited = std::pmr::vector<ParamOption const*>{m_lookup->get_globals().begin(), m_lookup->get_globals().end(), m_resource};
+	m_lookup = &m_local.emplace(cmd->args, *m_resource, inherited);
+	push_command(*cmd);
 	return {};
 }
 
+void Parser::push_command(ParamCommand const& cmd) {
+	if (!m_path) { m_path = std::allocate_shared<CommandPath>(std::pmr::polymorphic_allocator<>{m_resource}, *m_resource); }
+	if (!m_path->joined.empty()) { m_path->joined += ' '; }
+	m_path->joined += cmd.name;
+	m_path->names.push_back(cmd.name);
+	m_path->commands.push_back(&cmd);
+	// help text of the command also shows the current values of globals it inherits.
+	m_cursor = Cursor{.cmd = &cmd, .assigned = m_cursor.assigned_global, .assigned_global = m_cursor.assigned_global};
+	trace(cmd);
+}
+
+auto Parser::unrecognized_command(std::string_view const name) const -> Result {
+	return fail({.kind = DiagnosticKind::UnrecognizedCommand, .index = m_scanner.get_index(), .input = name, .candidates = {m_lookup->suggest_command(name)}});
+}
+
+auto Parser::ambiguous_option(std::string_view const word, std::span<Lookup::Entry<ParamOption> const> matches) const -> Result {
+	auto const second = std::ranges::find_if(matches, [first = matches.front().key](Lookup::Entry<ParamOption> const& entry) { return entry.key != first; });
+	auto const diagnostic = Diagnostic{.kind = DiagnosticKind::AmbiguousOption, .index = m_scanner.get_index(), .input = word, .candidates = {matches.front().key, second->key}};
+	if (!m_config.print_errors) { return fail(diagnostic); }
+
+	// matches are sorted by word, with duplicates adjacent.
+	auto possibilities = std::pmr::vector<std::string_view>{m_resource};
+	for (auto const& match : matches) {
+		if (possibilities.empty() || possibilities.back() != match.key) { possibilities.push_back(match.key); }
+	}
+	return fail(diagnostic, possibilities);
+}
+
+auto Parser::fail(Diagnostic diagnostic, std::span<std::string_view const> const possibilities) const -> Result {
+	diagnostic.exe_name = m_exe_name;
+	diagnostic.command = get_cmd_name();
+	auto ret = Result{to_parse_error(diagnostic.kind), diagnostic};
+	if (m_config.print_errors) { std::print(stderr, "{}", format_diagnostic(diagnostic, possibilities, *m_resource)); }
+	return ret;
+}
+
 auto Parser::parse_next() -> Result {
 	switch (m_scanner.get_token_type()) {
 	case TokenType::Argument: return parse_argument();
@@ -272,6 +161,34 @@ auto Parser::parse_next() -> Result {
 	return {};
 }
 
+auto Parser::parse_traced() -> Result {
+	auto* const event = m_trace.get();
+	if (event == nullptr) { return parse_next(); }
+
+	*event = TraceEvent{
+		.index = m_scanner.get_index(),
+		.input = m_scanner.get_arg(),
+		.token_type = m_scanner.get_token_type(),
+		.option_type = m_scanner.get_option_type(),
+	};
+	auto const start = std::chrono::steady_clock::now();
+	auto ret = parse_next();
+	event->elapsed = std::chrono::steady_clock::now() - start;
+	event->count = std::max(event->count, m_scanner.get_index() - event->index + 1);
+
+	if (ret.get_parse_error()) {
+		event->outcome = TraceOutcome::Failed;
+	} else if (ret.executed_builtin()) {
+		event->outcome = TraceOutcome::ExecutedBuiltin;
+	} else if (event->command != nullptr) {
+		event->outcome = TraceOutcome::SelectedCommand;
+	} else if (event->option != nullptr || event->positional != nullptr) {
+		event->outcome = TraceOutcome::Assigned;
+	}
+	m_config.tracer->on_token(*event);
+	return ret;
+}
+
 auto Parser::parse_option() -> Result {
 	switch (m_scanner.get_option_type()) {
 	case OptionType::Letters: return parse_letters();
@@ -287,14 +204,18 @@ auto Parser::parse_option() -> Result {
 auto Parser::parse_letters() -> Result {
 	auto letter = char{};
 	auto is_last = false;
-	while (m_scanner.next_letter(letter, is_last)) {
-		auto const* option = find_option(letter);
-		if (option == nullptr) { return ErrorPrinter{m_exe_name, get_cmd_name()}.invalid_option(letter); }
+	// inputs are views of each letter within the token, so diagnostics can outlive the parse.
+	for (auto letters = m_scanner.get_key(); m_scanner.next_letter(letter, is_last); letters = letters.substr(1)) {
+		auto const input = letters.substr(0, 1);
+		auto const* option = m_lookup->find_option(letter);
+		if (option == nullptr) { return fail({.kind = DiagnosticKind::InvalidOption, .index = m_scanner.get_index(), .input = input}); }
 		if (!is_last) {
-			if (!option->is_flag) { return ErrorPrinter{m_exe_name, get_cmd_name()}.option_requires_argument({&letter, 1}); }
+			if (!option->is_flag) { return fail({.kind = DiagnosticKind::OptionRequiresArgument, .index = m_scanner.get_index(), .input = input}); }
+			trace(*option);
 			[[maybe_unused]] auto const unused = option->assign({});
+			mark_assigned(*option);
 		} else {
-			return parse_last_option(*option, {&letter, 1});
+			return parse_last_option(*option, input);
 		}
 	}
 
@@ -304,90 +225,147 @@ auto Parser::parse_letters() -> Result {
 auto Parser::parse_word() -> Result {
 	auto const word = m_scanner.get_key();
 	if (try_builtin(word)) { return ExecutedBuiltin{}; }
-	auto const* option = find_option(word);
-	if (option == nullptr) { return ErrorPrinter{m_exe_name, get_cmd_name()}.unrecognized_option(word); }
-	return parse_last_option(*option, word);
+	if (word == "completions") { return print_completions(); }
+	if (word == "complete") { return print_matches(); }
+	auto const matches = m_lookup->match_option(word);
+	if (matches.empty()) { return unrecognized_option(word); }
+	if (matches.front().key != matches.back().key) { return ambiguous_option(word, matches); }
+	return parse_last_option(*matches.front().param, word);
+}
+
+auto Parser::unrecognized_option(std::string_view const word) const -> Result {
+	return fail({.kind = DiagnosticKind::UnrecognizedOption, .index = m_scanner.get_index(), .input = word, .candidates = {m_lookup->suggest_option(word)}});
 }
 
 auto Parser::parse_last_option(ParamOption const& option, std::string_view input) -> Result {
+	trace(option);
 	if (option.is_flag) {
-		if (!m_scanner.get_value().empty()) { return ErrorPrinter{m_exe_name, get_cmd_name()}.option_is_flag(input); }
+		if (!m_scanner.get_value().empty()) { return fail({.kind = DiagnosticKind::OptionIsFlag, .index = m_scanner.get_index(), .input = input}); }
 		[[maybe_unused]] auto const unused = option.assign({});
+		mark_assigned(option);
 		return {};
 	}
 
 	auto value = m_scanner.get_value();
 	if (value.empty()) {
-		if (m_scanner.peek() != TokenType::Argument) { return ErrorPrinter{m_exe_name, get_cmd_name()}.option_requires_argument(input); }
+		if (m_scanner.peek() != TokenType::Argument) {
+			return fail({.kind = DiagnosticKind::OptionRequiresArgument, .index = m_scanner.get_index(), .input = input});
+		}
 		m_scanner.next();
 		value = m_scanner.get_value();
 	}
-	if (!option.assign(value)) { return ErrorPrinter{m_exe_name, get_cmd_name()}.invalid_value(input, value); }
+	if (!option.assign(value)) { return fail({.kind = DiagnosticKind::InvalidValue, .index = m_scanner.get_index(), .input = input, .value = value}); }
+	mark_assigned(option);
 
 	return {};
 }
 
 auto Parser::parse_argument() -> Result {
-	if (m_has_commands && m_cursor.cmd == nullptr) { return select_command(); }
+	// a level with commands takes its first argument as one of them.
+	if (m_lookup->has_commands()) { return select_command(); }
 	return parse_positional();
 }
 
 auto Parser::parse_positional() -> Result {
 	auto const* pos = next_positional();
-	if (pos == nullptr) { return ErrorPrinter{m_exe_name, get_cmd_name()}.extraneous_argument(m_scanner.get_value()); }
-	if (!pos->assign(m_scanner.get_value())) { return ErrorPrinter{m_exe_name, get_cmd_name()}.invalid_value(pos->name, m_scanner.get_value()); }
+	if (pos == nullptr) { return fail({.kind = DiagnosticKind::ExtraneousArgument, .index = m_scanner.get_index(), .input = m_scanner.get_value()}); }
+	trace(*pos);
+	m_cursor.assigned = true;
+	if (pos->binds_stream()) { return parse_stream(*pos); }
+	if (pos->is_list && pos != m_list) {
+		// at most every remaining input (plus the peeked one) can end up in this list: reserve once up front.
+		m_list = pos;
+		pos->reserve(1 + m_scanner.get_args().size() + (m_scanner.peek() == TokenType::None ? 0 : 1));
+	}
+	if (pos->binds_batches() && m_scanner.get_slot() != nullptr) { return parse_batch(*pos); }
+	auto const assigned = pos->binds_slots() ? m_scanner.get_slot() != nullptr && pos->assign_slot(m_scanner.get_slot()) : pos->assign(m_scanner.get_value());
+	if (!assigned) { return fail({.kind = DiagnosticKind::InvalidValue, .index = m_scanner.get_index(), .input = pos->name, .value = m_scanner.get_value()}); }
 	return {};
 }
 
-auto Parser::try_builtin(std::string_view const word) const -> bool {
+auto Parser::parse_batch(ParamPositional const& list) -> Result {
+	auto const values = m_scanner.take_arguments();
+	if constexpr (trace_enabled_v) { m_trace.get()->count = values.size(); }
+	auto const executor = ThreadedBatch{m_config.batch_threads};
+	auto const assigned = list.assign_batch(values, m_config.batch_threads > 1 ? &executor : nullptr);
+	if (assigned < values.size()) {
+		// values were read from consecutive argv entries.
+		return fail({.kind = DiagnosticKind::InvalidValue, .index = m_scanner.get_index() + assigned, .input = list.name, .value = values[assigned]});
+	}
+	return {};
+}
+
+auto Parser::parse_stream(ParamPositional const& stream) -> Result {
+	// hand the rest of the input over to the stream, unread, and stop scanning.
+	stream.bind_stream(std::allocate_shared<ScannerSource>(std::pmr::polymorphic_allocator<>{m_resource}, m_scanner, m_response_files));
+	m_streamed = true;
+	return {};
+}
+
+auto Parser::render_builtin(std::string_view const word) const -> std::pmr::string {
+	auto ret = std::pmr::string{m_resource};
 	if (word == "help") {
 		auto info = m_info;
 		info.help_text = get_help_text();
-		print_help(info, m_exe_name, get_cmd_name(), m_args);
-		return true;
-	}
-
-	if (word == "usage") {
-		print_usage(m_exe_name, get_cmd_name(), m_args);
-		return true;
+		ret = format_help(info, m_exe_name, get_cmd_name(), *m_lookup, *m_resource);
+	} else {
+		ret = format_usage(m_exe_name, get_cmd_name(), m_lookup->get_args(), *m_resource);
 	}
+	ret += '\n';
+	return ret;
+}
 
+auto Parser::try_builtin(std::string_view const word) const -> bool {
 	if (word == "version") {
 		std::println("{}", m_info.version);
 		return true;
 	}
 
-	return false;
-}
+	if (word != "help" && word != "usage") { return false; }
 
-auto Parser::find_option(char const letter) const -> ParamOption const* {
-	for (auto const& arg : m_args) {
-		auto const* ret = std::get_if<ParamOption>(&arg.get_param());
-		if (ret != nullptr && ret->letter == letter) { return ret; }
+	// help prints current values as defaults: only cache (and reuse) text rendered before any were assigned.
+	if (m_tree == nullptr || m_cursor.assigned) {
+		write_stdout(render_builtin(word));
+		return true;
 	}
-	return nullptr;
+	auto& cached = word == "help" ? m_tree->cache.help : m_tree->cache.usage;
+	if (cached.empty()) { cached = render_builtin(word); }
+	write_stdout(cached);
+	return true;
 }
 
-auto Parser::find_option(std::string_view const word) const -> ParamOption const* {
-	for (auto const& arg : m_args) {
-		auto const* ret = std::get_if<ParamOption>(&arg.get_param());
-		if (ret != nullptr && ret->word == word) { return ret; }
+auto Parser::print_completions() -> Result {
+	auto value = m_scanner.get_value();
+	if (value.empty()) {
+		if (m_scanner.peek() != TokenType::Argument) {
+			return fail({.kind = DiagnosticKind::OptionRequiresArgument, .index = m_scanner.get_index(), .input = "completions"});
+		}
+		m_scanner.next();
+		value = m_scanner.get_value();
 	}
-	return nullptr;
+	auto const shell = to_shell(value);
+	if (!shell) { return fail({.kind = DiagnosticKind::InvalidValue, .index = m_scanner.get_index(), .input = "completions", .value = value}); }
+	write_stdout(format_completions(*shell, m_exe_name, m_root_args, *m_resource));
+	return ExecutedBuiltin{};
 }
 
-auto Parser::find_command(std::string_view const name) const -> ParamCommand const* {
-	for (auto const& arg : m_args) {
-		auto const* ret = std::get_if<ParamCommand>(&arg.get_param());
-		if (ret != nullptr && ret->name == name) { return ret; }
-	}
-	return nullptr;
+auto Parser::print_matches() -> Result {
+	// every remaining input is a word of the command line being completed, the last one partial.
+	auto words = std::pmr::vector<std::string_view>{m_resource};
+	while (m_scanner.next()) { words.push_back(m_scanner.get_arg()); }
+	if (words.empty()) { words.emplace_back(); }
+
+	auto local = std::optional<CommandTree>{};
+	auto const& tree = m_root_tree == nullptr ? local.emplace(m_root_args, *m_resource) : *m_root_tree;
+	write_stdout(format_matches(tree, words, *m_resource));
+	return ExecutedBuiltin{};
 }
 
 auto Parser::next_positional() -> ParamPositional const* {
+	auto const args = m_lookup->get_args();
 	auto& index = m_cursor.next_pos;
-	for (; index < m_args.size(); ++index) {
-		auto const& arg = m_args[index];
+	for (; index < args.size(); ++index) {
+		auto const& arg = args[index];
 		auto const* ret = std::get_if<ParamPositional>(&arg.get_param());
 		if (ret != nullptr) {
 			if (!ret->is_list) { ++index; }
@@ -398,24 +376,95 @@ auto Parser::next_positional() -> ParamPositional const* {
 }
 
 auto Parser::check_required() -> Result {
-	if (m_has_commands && m_cursor.cmd == nullptr) { return ErrorPrinter{m_exe_name}.missing_argument("command"); }
+	// only the innermost level can be left without a command, and its positionals are the only ones still unassigned.
+	if (m_lookup->has_commands()) { return fail({.kind = DiagnosticKind::MissingArgument, .input = "command"}); }
 
 	for (auto const* p = next_positional(); p != nullptr; p = next_positional()) {
-		if (p->is_required()) { return ErrorPrinter{m_exe_name, get_cmd_name()}.missing_argument(p->name); }
+		if (p->is_required()) { return fail({.kind = DiagnosticKind::MissingArgument, .input = p->name}); }
 		if (p->is_list) { return {}; }
 	}
 
 	return {};
 }
+
+void Parser::mark_assigned(ParamOption const& option) {
+	m_cursor.assigned = true;
+	if (option.global) { m_cursor.assigned_global = true; }
+	if (option.has_fallback()) { m_assigned.insert(&option); }
+}
+
+auto Parser::resolve_fallbacks() -> Result {
+	auto fallbacks = Fallbacks{};
+	auto result = resolve_fallbacks(m_root_args, fallbacks);
+	if (result.early_return() || !m_path) { return result; }
+	for (auto const* cmd : m_path->commands) {
+		result = resolve_fallbacks(cmd->args, fallbacks);
+		if (result.early_return()) { return result; }
+	}
+	return result;
+}
+
+auto Parser::resolve_fallbacks(std::span<Arg const> const args, Fallbacks& fallbacks) -> Result {
+	for (auto const& arg : args) {
+		auto const* option = std::get_if<ParamOption>(&arg.get_param());
+		if (option == nullptr || !option->has_fallback() || m_assigned.contains(option)) { continue; }
+
+		auto source = DiagnosticKind::InvalidEnvironment;
+		auto name = option->env;
+		auto value = name.empty() ? std::optional<std::string_view>{} : find_env(fallbacks, name);
+		if (!value && !option->config_key.empty()) {
+			source = DiagnosticKind::InvalidConfig;
+			name = option->config_key;
+			value = find_config(fallbacks, name);
+		}
+		if (!value) { continue; }
+
+		auto assigned = true;
+		if (!option->is_flag) {
+			assigned = option->assign(*value);
+		} else if (*value == "1" || *value == "true") {
+			assigned = option->assign({});
+		} else {
+			assigned = value->empty() || *value == "0" || *value == "false";
+		}
+		if (!assigned) { return fail({.kind = source, .input = name, .value = *value}); }
+	}
+	return {};
+}
+
+auto Parser::find_env(Fallbacks& fallbacks, std::string_view const name) const -> std::optional<std::string_view> {
+	if (!fallbacks.env) {
+		fallbacks.env.emplace(*m_resource);
+		fallbacks.env->add_environment(m_config.environment == nullptr ? get_process_environment() : m_config.environment);
+	}
+	return fallbacks.env->find(name);
+}
+
+auto Parser::find_config(Fallbacks& fallbacks, std::string_view const key) -> std::optional<std::string_view> {
+	if (!fallbacks.config) {
+		fallbacks.config.emplace(*m_resource);
+		if (m_config.config_file != nullptr) {
+			// mapped like response files, so string_view outputs stay valid while the Result is alive.
+			if (!m_response_files) { m_response_files = std::allocate_shared<ResponseFiles>(std::pmr::polymorphic_allocator<>{m_resource}, *m_resource); }
+			if (auto const text = m_response_files->open(m_config.config_file)) { fallbacks.config->add_config({text->data(), text->size()}); }
+		}
+	}
+	return fallbacks.config->find(key);
+}
 } // namespace cliq
 
-[[nodiscard]] auto cliq::parse(AppInfo const& info, std::span<Arg const> args, int argc, char const* const* argv) -> Result {
+[[nodiscard]] auto cliq::parse(AppInfo const& info, std::span<Arg const> args, int argc, char const* const* argv, ParseConfig const& config) -> Result {
 	auto exe_name = std::string_view{"<app>"};
 	auto cli_args = std::span{argv, std::size_t(argc)};
 	if (!cli_args.empty()) {
 		exe_name = get_exe_name(cli_args.front());
 		cli_args = cli_args.subspan(1);
 	};
-	auto parser = Parser{info, exe_name, cli_args};
+	auto parser = Parser{info, exe_name, cli_args, config};
+	return parser.parse(args);
+}
+
+[[nodiscard]] auto cliq::parse_line(AppInfo const& info, std::span<Arg const> args, std::span<char> line, ParseConfig const& config) -> Result {
+	auto parser = Parser{info, "<app>", Scanner{Tokenizer{line}}, config};
 	return parser.parse(args);
 }
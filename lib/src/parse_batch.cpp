@@ -0,0 +1,58 @@
+#include <cliq/parse_batch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cliq {
+namespace {
+class SharedQueue : public detail::BatchQueue {
+  public:
+	explicit SharedQueue(std::size_t const count) : m_count(count) {}
+
+	[[nodiscard]] auto take() -> std::size_t final { return m_next.fetch_add(1, std::memory_order_relaxed); }
+
+	/// \brief Keep the first exception to rethrow, and stop handing out jobs.
+	void fail(std::exception_ptr error) {
+		auto const lock = std::scoped_lock{m_mutex};
+		if (!m_error) { m_error = std::move(error); }
+		m_next.store(m_count, std::memory_order_relaxed);
+	}
+
+	void rethrow_error() const {
+		if (m_error) { std::rethrow_exception(m_error); }
+	}
+
+  private:
+	std::size_t m_count;
+	std::atomic<std::size_t> m_next{};
+	std::mutex m_mutex{};
+	std::exception_ptr m_error{};
+};
+} // namespace
+
+void detail::BatchQueue::run(std::size_t const count, std::size_t threads, Worker const worker, void const* context) {
+	if (threads == 0) { threads = std::thread::hardware_concurrency(); }
+	threads = std::clamp(threads, std::size_t{1}, std::max(count, std::size_t{1}));
+
+	auto queue = SharedQueue{count};
+	auto const work = [&] {
+		try {
+			worker(context, queue);
+		} catch (...) {
+			queue.fail(std::current_exception());
+		}
+	};
+
+	{
+		auto workers = std::vector<std::jthread>{};
+		workers.reserve(threads - 1);
+		for (auto i = std::size_t{1}; i < threads; ++i) { workers.emplace_back(work); }
+		work();
+	}
+	// jthreads have joined: no worker can still be writing the error.
+	queue.rethrow_error();
+}
+} // namespace cliq
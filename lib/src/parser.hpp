@@ -1,49 +1,141 @@
 #pragma once
 #include <cliq/app_info.hpp>
+#include <cliq/parse_config.hpp>
 #include <cliq/result.hpp>
+#include <cliq/trace.hpp>
+#include <command_tree.hpp>
+#include <key_values.hpp>
 #include <scanner.hpp>
+#include <optional>
+#include <unordered_set>
 
 namespace cliq {
+/// \brief Storage for the event of the token being parsed: empty unless tracing is compiled in.
+template <bool Enabled>
+struct TraceSlot {
+	[[nodiscard]] constexpr auto get() -> TraceEvent* { return &event; }
+
+	TraceEvent event{};
+};
+
+template <>
+struct TraceSlot<false> {
+	[[nodiscard]] static constexpr auto get() -> TraceEvent* { return nullptr; }
+};
+
 class Parser {
   public:
-	explicit Parser(AppInfo const& info, std::string_view const exe_name, std::span<char const* const> cli_args)
-		: m_info(info), m_exe_name(exe_name), m_scanner(cli_args) {}
+	explicit Parser(AppInfo const& info, std::string_view const exe_name, std::span<char const* const> cli_args, ParseConfig const& config = {})
+		: m_info(info), m_exe_name(exe_name), m_config(config), m_resource(&config.get_resource()),
+		  m_response_files(make_response_files(config, *m_resource)), m_scanner(cli_args, m_response_files.get()), m_assigned(m_resource) {}
+
+	explicit Parser(AppInfo const& info, std::string_view const exe_name, Scanner const& scanner, ParseConfig const& config = {})
+		: m_info(info), m_exe_name(exe_name), m_config(config), m_resource(&config.get_resource()), m_scanner(scanner), m_assigned(m_resource) {}
 
+	/// \brief Parse into args, building lookups on demand.
 	[[nodiscard]] auto parse(std::span<Arg const> args) -> Result;
+	/// \brief Parse into a precompiled tree of lookups.
+	[[nodiscard]] auto parse(CommandTree const& tree) -> Result;
 
   private:
 	struct Cursor {
 		ParamCommand const* cmd{};
 		std::size_t next_pos{};
+		/// \brief Whether any output of cmd (or the root), or any global option it inherits, has been assigned.
+		bool assigned{};
+		/// \brief Whether any global option has been assigned so far (at any level).
+		bool assigned_global{};
 	};
 
+	[[nodiscard]] static auto make_response_files(ParseConfig const& config, std::pmr::memory_resource& resource) -> std::shared_ptr<ResponseFiles>;
+
+	/// \brief Selected commands, outermost first; shared with the Result so views into it stay valid.
+	struct CommandPath {
+		explicit CommandPath(std::pmr::memory_resource& resource) : commands(&resource), names(&resource), joined(&resource) {}
+
+		std::pmr::vector<ParamCommand const*> commands;
+		std::pmr::vector<std::string_view> names;
+		/// \brief Names separated by spaces, for help and error text.
+		std::pmr::string joined;
+		/// \brief Kept alive alongside, when both are in use.
+		std::shared_ptr<ResponseFiles> response_files{};
+	};
+
+	struct Fallbacks {
+		std::optional<KeyValues> env{};
+		std::optional<KeyValues> config{};
+	};
+
+	auto run() -> Result;
+	auto scan() -> Result;
 	auto select_command() -> Result;
+	void push_command(ParamCommand const& cmd);
+	[[nodiscard]] auto unrecognized_command(std::string_view name) const -> Result;
 	auto parse_next() -> Result;
+	auto parse_traced() -> Result;
 	auto parse_option() -> Result;
 	auto parse_letters() -> Result;
 	auto parse_word() -> Result;
+	[[nodiscard]] auto unrecognized_option(std::string_view word) const -> Result;
+	[[nodiscard]] auto ambiguous_option(std::string_view word, std::span<Lookup::Entry<ParamOption> const> matches) const -> Result;
 	auto parse_last_option(ParamOption const& option, std::string_view input) -> Result;
 	auto parse_argument() -> Result;
 	auto parse_positional() -> Result;
+	auto parse_batch(ParamPositional const& list) -> Result;
+	auto parse_stream(ParamPositional const& stream) -> Result;
 
+	[[nodiscard]] auto render_builtin(std::string_view word) const -> std::pmr::string;
 	[[nodiscard]] auto try_builtin(std::string_view word) const -> bool;
-	[[nodiscard]] auto find_option(char letter) const -> ParamOption const*;
-	[[nodiscard]] auto find_option(std::string_view word) const -> ParamOption const*;
-	[[nodiscard]] auto find_command(std::string_view name) const -> ParamCommand const*;
+	auto print_completions() -> Result;
+	auto print_matches() -> Result;
 
 	[[nodiscard]] auto next_positional() -> ParamPositional const*;
 
 	[[nodiscard]] auto check_required() -> Result;
 
-	[[nodiscard]] auto get_cmd_name() const -> std::string_view { return m_cursor.cmd == nullptr ? "" : m_cursor.cmd->name; }
+	void mark_assigned(ParamOption const& option);
+	[[nodiscard]] auto resolve_fallbacks() -> Result;
+	[[nodiscard]] auto resolve_fallbacks(std::span<Arg const> args, Fallbacks& fallbacks) -> Result;
+	[[nodiscard]] auto find_env(Fallbacks& fallbacks, std::string_view name) const -> std::optional<std::string_view>;
+	[[nodiscard]] auto find_config(Fallbacks& fallbacks, std::string_view key) -> std::optional<std::string_view>;
+
+	/// \brief Complete diagnostic with the executable and command names, and print it unless disabled.
+	/// \param possibilities Every word an ambiguous option abbreviates, printed in full (the diagnostic keeps two).
+	[[nodiscard]] auto fail(Diagnostic diagnostic, std::span<std::string_view const> possibilities = {}) const -> Result;
+
+	void trace(ParamOption const& option) {
+		if constexpr (trace_enabled_v) { m_trace.get()->option = &option; }
+	}
+	void trace(ParamPositional const& positional) {
+		if constexpr (trace_enabled_v) { m_trace.get()->positional = &positional; }
+	}
+	void trace(ParamCommand const& command) {
+		if constexpr (trace_enabled_v) { m_trace.get()->command = &command; }
+	}
+
+	[[nodiscard]] auto get_cmd_name() const -> std::string_view { return m_path ? std::string_view{m_path->joined} : std::string_view{}; }
 	[[nodiscard]] auto get_help_text() const -> std::string_view { return m_cursor.cmd == nullptr ? m_info.help_text : m_cursor.cmd->help_text; }
 
 	AppInfo const& m_info;
 	std::string_view m_exe_name;
+	ParseConfig m_config;
+	std::pmr::memory_resource* m_resource;
 
+	std::shared_ptr<ResponseFiles> m_response_files{};
 	Scanner m_scanner;
-	std::span<Arg const> m_args{};
+	std::optional<Lookup> m_local{};
+	Lookup const* m_lookup{};
+	CommandTree const* m_tree{};
+	CommandTree const* m_root_tree{};
+	std::span<Arg const> m_root_args{};
 	Cursor m_cursor{};
-	bool m_has_commands{};
+	std::shared_ptr<CommandPath> m_path{};
+	ParamPositional const* m_list{};
+	/// \brief Whether the rest of the input was handed to a stream list.
+	bool m_streamed{};
+	/// \brief Options with fallbacks that were passed on the command line.
+	std::pmr::unordered_set<ParamOption const*> m_assigned;
+	/// \brief Event for the token being parsed, when tracing.
+	[[no_unique_address]] TraceSlot<trace_enabled_v> m_trace{};
 };
 } // namespace cliq
@@ -0,0 +1,98 @@
+#include <response_files.hpp>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cliq {
+MappedFile::MappedFile(MappedFile&& rhs) noexcept : m_data(std::exchange(rhs.m_data, nullptr)), m_size(std::exchange(rhs.m_size, 0)) {}
+
+auto MappedFile::operator=(MappedFile&& rhs) noexcept -> MappedFile& {
+	if (&rhs != this) {
+		close();
+		m_data = std::exchange(rhs.m_data, nullptr);
+		m_size = std::exchange(rhs.m_size, 0);
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile() { close(); }
+
+#if defined(_WIN32)
+auto MappedFile::open(char const* path) -> bool {
+	close();
+	auto* file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { return false; }
+	auto size = LARGE_INTEGER{};
+	if (GetFileSizeEx(file, &size) == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	if (size.QuadPart == 0) {
+		CloseHandle(file);
+		return true;
+	}
+	auto* mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr) { return false; }
+	auto* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(mapping);
+	if (data == nullptr) { return false; }
+	m_data = static_cast<char*>(data);
+	m_size = std::size_t(size.QuadPart);
+	return true;
+}
+
+void MappedFile::close() {
+	if (m_data != nullptr) { UnmapViewOfFile(m_data); }
+	m_data = nullptr;
+	m_size = 0;
+}
+#else
+auto MappedFile::open(char const* path) -> bool {
+	close();
+	auto const fd = ::open(path, O_RDONLY | O_CLOEXEC); // NOLINT(cppcoreguidelines-pro-type-vararg)
+	if (fd < 0) { return false; }
+	struct stat info{};
+	if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+		::close(fd);
+		return false;
+	}
+	if (info.st_size == 0) {
+		::close(fd);
+		return true;
+	}
+	auto const size = std::size_t(info.st_size);
+	auto* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (data == MAP_FAILED) { return false; } // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+	::madvise(data, size, MADV_SEQUENTIAL);
+	m_data = static_cast<char*>(data);
+	m_size = size;
+	return true;
+}
+
+void MappedFile::close() {
+	if (m_data != nullptr) { ::munmap(m_data, m_size); }
+	m_data = nullptr;
+	m_size = 0;
+}
+#endif
+
+auto ResponseFiles::open(std::string_view const path) -> std::optional<std::span<char>> {
+	m_path = path; // null-terminated copy
+	auto file = MappedFile{};
+	if (!file.open(m_path.c_str())) { return {}; }
+	auto const ret = file.get_text();
+	m_files.push_back(std::move(file));
+	return ret;
+}
+} // namespace cliq
@@ -0,0 +1,47 @@
+#pragma once
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace cliq {
+/// \brief Read-only file mapped copy-on-write: writes (eg in-place tokenizing) touch only private pages.
+class MappedFile {
+  public:
+	MappedFile() = default;
+
+	MappedFile(MappedFile&& rhs) noexcept;
+	auto operator=(MappedFile&& rhs) noexcept -> MappedFile&;
+	MappedFile(MappedFile const&) = delete;
+	auto operator=(MappedFile const&) = delete;
+	~MappedFile();
+
+	/// \brief Map a file.
+	/// \param path Null-terminated path.
+	/// \returns false if the file could not be opened or mapped.
+	[[nodiscard]] auto open(char const* path) -> bool;
+
+	[[nodiscard]] auto get_text() const -> std::span<char> { return {m_data, m_size}; }
+
+  private:
+	void close();
+
+	char* m_data{};
+	std::size_t m_size{};
+};
+
+/// \brief Files (response files, config file) mapped during a parse, kept alive while outputs may point into them.
+class ResponseFiles {
+  public:
+	explicit ResponseFiles(std::pmr::memory_resource& resource) : m_files(&resource), m_path(&resource) {}
+
+	/// \brief Map a response file.
+	/// \returns Mapped text, or nullopt on failure.
+	[[nodiscard]] auto open(std::string_view path) -> std::optional<std::span<char>>;
+
+  private:
+	std::pmr::vector<MappedFile> m_files;
+	std::pmr::string m_path;
+};
+} // namespace cliq
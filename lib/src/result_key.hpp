@@ -0,0 +1,7 @@
+#pragma once
+#include <cliq/result.hpp>
+
+namespace cliq::detail {
+/// \brief Only defined in this private header, so only cliq can attach storage to a Result.
+class ResultKey {};
+} // namespace cliq::detail
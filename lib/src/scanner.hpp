@@ -1,30 +1,76 @@
 #pragma once
+#include <response_files.hpp>
 #include <token.hpp>
+#include <tokenizer.hpp>
 #include <span>
 
 namespace cliq {
+enum class ScanError {
+	None,
+	UnterminatedQuote,
+	UnreadableResponseFile,
+};
+
 class Scanner {
   public:
-	explicit constexpr Scanner(std::span<char const* const> args) : m_args(args) {
-		if (!m_args.empty()) { m_next = to_token(m_args.front()); }
+	/// \param response_files If set, argv entries of the form @path are expanded into the words of the file at path.
+	/// Expansion is lazy and not recursive; args after "--" are never expanded.
+	explicit constexpr Scanner(std::span<char const* const> args, ResponseFiles* response_files = nullptr)
+		: m_args(args), m_response_files(response_files) {
+		set_next();
 	}
 
+	explicit constexpr Scanner(Tokenizer const& tokenizer) : m_tokenizer(tokenizer) { set_next(); }
+
 	constexpr auto next() -> bool {
 		advance();
-		if (m_current.token.token_type == TokenType::ForceArgs) { m_force_args = true; }
 		return m_current.token.token_type != TokenType::None;
 	}
 
+	/// \brief Get the args not yet scanned (excluding the peeked one).
 	[[nodiscard]] constexpr auto get_args() const -> std::span<char const* const> { return m_args; }
 
+	/// \brief Get the error that stopped scanning, if any.
+	[[nodiscard]] constexpr auto get_error() const -> ScanError {
+		if (m_tokenizer.is_malformed()) { return ScanError::UnterminatedQuote; }
+		return m_error;
+	}
+
+	/// \brief Get the input that caused the error returned by get_error().
+	[[nodiscard]] constexpr auto get_error_input() const -> std::string_view { return m_error_input; }
+	/// \brief Get the index of the input word that caused the error returned by get_error().
+	[[nodiscard]] constexpr auto get_error_index() const -> std::size_t { return m_inputs; }
+
+	/// \brief Get the index of the input word the current token was read from (after response file expansion).
+	[[nodiscard]] constexpr auto get_index() const -> std::size_t { return m_current.index; }
+
 	[[nodiscard]] constexpr auto peek() const -> TokenType { return m_next.token_type; }
 
 	[[nodiscard]] constexpr auto get_token_type() const -> TokenType { return m_current.token.token_type; }
 	[[nodiscard]] constexpr auto get_option_type() const -> OptionType { return m_current.token.option_type; }
 
+	/// \brief Get the unprocessed input the current token was read from.
+	[[nodiscard]] constexpr auto get_arg() const -> std::string_view { return m_current.token.arg; }
 	[[nodiscard]] constexpr auto get_key() const -> std::string_view { return m_current.key; }
 	[[nodiscard]] constexpr auto get_value() const -> std::string_view { return m_current.value; }
 
+	/// \brief Get the argv entry the current token was read from.
+	/// \returns nullptr if the token was read from a tokenizer (parse_line() or a response file).
+	[[nodiscard]] constexpr auto get_slot() const -> char const* const* { return m_current.slot; }
+
+	/// \brief Consume the run of argument tokens read from consecutive argv entries, starting with the current one.
+	/// The next call to next() advances to the first token after the run.
+	/// \returns Empty span if the current token is not an argument read from argv.
+	constexpr auto take_arguments() -> std::span<char const* const> {
+		if (m_current.slot == nullptr || m_current.token.token_type != TokenType::Argument) { return {}; }
+		auto count = std::size_t{1};
+		while (m_next.token_type == TokenType::Argument && m_next_slot == m_current.slot + count) {
+			++count;
+			set_next();
+		}
+		return {m_current.slot, count};
+	}
+
 	constexpr auto next_letter(char& out_letter, bool& out_is_last) -> bool {
 		if (m_current.token.option_type != OptionType::Letters || m_current.key.empty()) { return false; }
 		out_letter = m_current.key.front();
@@ -45,19 +91,53 @@ class Scanner {
 			return;
 		}
 		m_current.token = m_next;
+		m_current.slot = m_next_slot;
+		m_current.index = m_next_index;
+		if (m_current.token.token_type == TokenType::ForceArgs) { m_force_args = true; }
 		set_key_value();
 		set_next();
 	}
 
 	constexpr void set_next() {
-		if (m_args.size() <= 1) {
-			m_args = {};
+		auto input = std::string_view{};
+		if (!next_input(input)) {
 			m_next = {};
 			return;
 		}
-		m_next = to_token(m_args[1]);
-		if (m_force_args) { m_next.token_type = TokenType::Argument; }
+		if (m_force_args || input.empty()) {
+			m_next = Token{.arg = input, .value = input, .token_type = TokenType::Argument};
+			return;
+		}
+		m_next = to_token(input);
+	}
+
+	constexpr auto next_input(std::string_view& out) -> bool {
+		m_next_slot = nullptr;
+		m_next_index = m_inputs;
+		if (m_tokenizer.next(out)) {
+			++m_inputs;
+			return true;
+		}
+		if (m_tokenizer.is_malformed() || m_args.empty()) { return false; }
+		m_next_slot = m_args.data();
+		out = m_args.front();
 		m_args = m_args.subspan(1);
+		if (m_response_files == nullptr || m_force_args || out.size() < 2 || !out.starts_with('@')) {
+			++m_inputs;
+			return true;
+		}
+		return expand(out);
+	}
+
+	auto expand(std::string_view& out) -> bool {
+		auto const text = m_response_files->open(out.substr(1));
+		if (!text) {
+			m_error = ScanError::UnreadableResponseFile;
+			m_error_input = out;
+			return false;
+		}
+		m_tokenizer = Tokenizer{*text};
+		return next_input(out);
 	}
 
 	constexpr void set_key_value() {
@@ -75,13 +155,23 @@ class Scanner {
 	}
 
 	std::span<char const* const> m_args{};
+	Tokenizer m_tokenizer{};
+	ResponseFiles* m_response_files{};
+	ScanError m_error{};
+	std::string_view m_error_input{};
 
 	struct {
 		Token token{};
 		std::string_view key{};
 		std::string_view value{};
+		char const* const* slot{};
+		std::size_t index{};
 	} m_current{};
 	Token m_next{};
+	char const* const* m_next_slot{};
+	std::size_t m_next_index{};
+	/// \brief Number of input words read (excluding response file arguments, including their words).
+	std::size_t m_inputs{};
 	bool m_force_args{};
 };
 } // namespace cliq
@@ -0,0 +1,43 @@
+#pragma once
+#include <scanner.hpp>
+#include <memory>
+#include <utility>
+
+namespace cliq {
+/// \brief Feeds a Stream from a copy of the parser's Scanner, positioned on the stream's first word.
+class ScannerSource : public StreamSource {
+  public:
+	explicit ScannerSource(Scanner const& scanner, std::shared_ptr<ResponseFiles> response_files)
+		: m_scanner(scanner), m_response_files(std::move(response_files)) {}
+
+	[[nodiscard]] auto next(std::string_view& out) -> bool final {
+		// the current token was already scanned as an argument.
+		if (std::exchange(m_first, false)) {
+			out = m_scanner.get_value();
+			return true;
+		}
+		while (m_scanner.next()) {
+			// everything else is a value too: only the first "--" is a separate token.
+			if (m_scanner.get_token_type() == TokenType::ForceArgs && !std::exchange(m_skipped_force_args, true)) { continue; }
+			out = m_scanner.get_arg();
+			return true;
+		}
+		return false;
+	}
+
+	[[nodiscard]] auto get_error_input() const -> std::optional<std::string_view> final {
+		switch (m_scanner.get_error()) {
+		case ScanError::None: return {};
+		case ScanError::UnreadableResponseFile: return m_scanner.get_error_input();
+		default: return std::string_view{};
+		}
+	}
+
+  private:
+	Scanner m_scanner;
+	/// \brief Keeps response files open (and mapped) while the scanner reads from them.
+	std::shared_ptr<ResponseFiles> m_response_files;
+	bool m_first{true};
+	bool m_skipped_force_args{};
+};
+} // namespace cliq
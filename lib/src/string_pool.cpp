@@ -0,0 +1,14 @@
+#include <cliq/string_pool.hpp>
+#include <algorithm>
+
+namespace cliq {
+StringPool::StringPool(std::pmr::memory_resource& resource) : m_arena(&resource), m_strings(&resource) {}
+
+auto StringPool::intern(std::string_view const text) -> std::string_view {
+	if (auto const it = m_strings.find(text); it != m_strings.end()) { return *it; }
+	auto* data = static_cast<char*>(m_arena.allocate(text.size() + 1, alignof(char)));
+	std::ranges::copy(text, data);
+	data[text.size()] = '\0';
+	return *m_strings.insert(std::string_view{data, text.size()}).first;
+}
+} // namespace cliq
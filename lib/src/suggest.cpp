@@ -0,0 +1,52 @@
+#include <suggest.hpp>
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace cliq {
+auto edit_distance(std::string_view const a, std::string_view const b, std::size_t const max_distance) -> std::size_t {
+	auto const exceeded = max_distance + 1;
+	if (a.size() > NearestWord::max_length_v || b.size() > NearestWord::max_length_v) { return exceeded; }
+	if ((a.size() > b.size() ? a.size() - b.size() : b.size() - a.size()) > max_distance) { return exceeded; }
+
+	// three rolling rows of the DP table: two back (for transpositions), previous, current.
+	using Row = std::array<std::size_t, NearestWord::max_length_v + 1>;
+	auto rows = std::array<Row, 3>{};
+	auto* before = &rows[0];
+	auto* previous = &rows[1];
+	auto* current = &rows[2];
+	for (auto j = std::size_t{}; j <= b.size(); ++j) { (*previous)[j] = j; }
+
+	for (auto i = std::size_t{1}; i <= a.size(); ++i) {
+		(*current)[0] = i;
+		auto row_min = i;
+		for (auto j = std::size_t{1}; j <= b.size(); ++j) {
+			auto const cost = std::size_t{a[i - 1] == b[j - 1] ? 0u : 1u};
+			auto value = std::min({(*previous)[j] + 1, (*current)[j - 1] + 1, (*previous)[j - 1] + cost});
+			if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) { value = std::min(value, (*before)[j - 2] + 1); }
+			(*current)[j] = value;
+			row_min = std::min(row_min, value);
+		}
+		// distances never decrease down the table: stop once every cell is over the bound.
+		if (row_min > max_distance) { return exceeded; }
+		std::swap(before, previous);
+		std::swap(previous, current);
+	}
+	return std::min((*previous)[b.size()], exceeded);
+}
+
+NearestWord::NearestWord(std::string_view const word) : m_word(word), m_distance(word.size() <= 4 ? 1u : 2u) {
+	if (m_word.size() > max_length_v) { m_word = {}; }
+}
+
+void NearestWord::add(std::string_view const candidate) {
+	if (m_word.empty() || candidate.empty()) { return; }
+	auto const distance = edit_distance(m_word, candidate, m_distance);
+	if (distance > m_distance) { return; }
+	if (distance == m_distance && !m_nearest.empty()) {
+		if (candidate.size() != m_nearest.size() ? candidate.size() > m_nearest.size() : candidate >= m_nearest) { return; }
+	}
+	m_nearest = candidate;
+	m_distance = distance;
+}
+} // namespace cliq
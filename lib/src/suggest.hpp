@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace cliq {
+/// \brief Optimal string alignment (restricted Damerau-Levenshtein) distance between a and b.
+/// \returns max_distance + 1 as soon as the distance is known to exceed max_distance.
+[[nodiscard]] auto edit_distance(std::string_view a, std::string_view b, std::size_t max_distance) -> std::size_t;
+
+/// \brief Search for the closest of a sequence of candidates within a small edit distance of a word:
+/// 1 for words of up to 4 characters, else 2. Ties go to the shorter, then lexicographically smaller candidate.
+/// Views point into the candidates, which must outlive this object.
+class NearestWord {
+  public:
+	/// \brief Longest word considered: longer ones are never suggested.
+	static constexpr std::size_t max_length_v{63};
+
+	explicit NearestWord(std::string_view word);
+
+	void add(std::string_view candidate);
+
+	/// \returns Closest candidate added so far, empty if none are close enough.
+	[[nodiscard]] auto get() const -> std::string_view { return m_nearest; }
+
+  private:
+	std::string_view m_word;
+	std::string_view m_nearest{};
+	std::size_t m_distance{};
+};
+} // namespace cliq
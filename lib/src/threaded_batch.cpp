@@ -0,0 +1,61 @@
+#include <threaded_batch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cliq {
+auto ThreadedBatch::run(std::size_t const count, Convert const convert, void const* context) const -> std::size_t {
+	auto const chunks = count / min_chunk_v;
+	if (m_threads < 2 || chunks < 2) { return convert(context, 0, count); }
+
+	// a few chunks per thread, so threads finishing early pick up the slack.
+	auto const threads = std::min(m_threads, chunks);
+	auto const chunk_size = std::max(min_chunk_v, count / (threads * 4));
+	auto next = std::atomic<std::size_t>{};
+	auto failed = std::atomic<std::size_t>{count};
+	auto error_mutex = std::mutex{};
+	auto error = std::exception_ptr{};
+	auto error_index = count;
+
+	auto const fail = [&failed](std::size_t const index) {
+		auto current = failed.load(std::memory_order_relaxed);
+		while (index < current && !failed.compare_exchange_weak(current, index, std::memory_order_relaxed)) {}
+	};
+
+	auto const work = [&] {
+		while (true) {
+			auto const first = next.fetch_add(chunk_size, std::memory_order_relaxed);
+			// chunks are taken in order: once past a failure, none of the rest can fail earlier.
+			if (first >= count || first > failed.load(std::memory_order_relaxed)) { return; }
+			auto const last = std::min(first + chunk_size, count);
+			auto index = last;
+			try {
+				index = convert(context, first, last);
+			} catch (...) {
+				// a serial conversion would have thrown only if no earlier value failed: keep the earliest chunk's exception.
+				auto const lock = std::scoped_lock{error_mutex};
+				if (first < error_index) {
+					error = std::current_exception();
+					error_index = first;
+				}
+				index = first;
+			}
+			if (index != last) { fail(index); }
+		}
+	};
+
+	{
+		auto workers = std::vector<std::jthread>{};
+		workers.reserve(threads - 1);
+		for (auto i = std::size_t{1}; i < threads; ++i) { workers.emplace_back(work); }
+		work();
+	}
+	// jthreads have joined: every chunk before the first failure has been converted.
+	auto const ret = failed.load(std::memory_order_relaxed);
+	if (error && error_index == ret) { std::rethrow_exception(error); }
+	return ret;
+}
+} // namespace cliq
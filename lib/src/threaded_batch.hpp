@@ -0,0 +1,18 @@
+#pragma once
+#include <cliq/binding.hpp>
+
+namespace cliq {
+/// \brief Converts a batch in fixed size chunks, handed out in order to a set of threads (including the calling one).
+class ThreadedBatch : public BatchExecutor {
+  public:
+	/// \brief Batches smaller than this are converted on the calling thread.
+	static constexpr std::size_t min_chunk_v{4096};
+
+	explicit ThreadedBatch(std::size_t const threads) : m_threads(threads) {}
+
+	[[nodiscard]] auto run(std::size_t count, Convert convert, void const* context) const -> std::size_t final;
+
+  private:
+	std::size_t m_threads;
+};
+} // namespace cliq
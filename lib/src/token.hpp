@@ -1,20 +1,8 @@
 #pragma once
+#include <cliq/token_type.hpp>
 #include <string_view>
 
 namespace cliq {
-enum class TokenType {
-	None,
-	Option,	   // -[-][A-z]+[=[A-z]+]
-	Argument,  // [A-z]+
-	ForceArgs, // --
-};
-
-enum class OptionType {
-	None,
-	Letters, // -[A-z]+[=[A-z]+]
-	Word,	 // --[A-z]+[=[A-z]+]
-};
-
 struct Token {
 	std::string_view arg{};
 	std::string_view value{};
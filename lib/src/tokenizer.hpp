@@ -0,0 +1,62 @@
+#pragma once
+#include <span>
+#include <string_view>
+
+namespace cliq {
+/// \brief Splits a command line into shell-style words, in place.
+/// Supports whitespace separation, single quotes (literal), double quotes (where backslash escapes '"' and '\')
+/// and backslash escapes outside quotes. Quotes and escapes are removed by compacting each word within the
+/// passed buffer, so words are views into it and nothing is copied or allocated.
+class Tokenizer {
+  public:
+	Tokenizer() = default;
+
+	explicit constexpr Tokenizer(std::span<char> text) : m_text(text) {}
+
+	/// \brief Get the next word.
+	/// \returns false if there are no more words or the input is malformed.
+	constexpr auto next(std::string_view& out) -> bool {
+		skip_whitespace();
+		if (m_read >= m_text.size()) { return false; }
+
+		auto const start = m_read;
+		auto write = m_read;
+		auto quote = '\0';
+		for (; m_read < m_text.size(); ++m_read) {
+			auto const c = m_text[m_read];
+			if (quote == '\0' && is_space(c)) { break; }
+			if (c == quote) {
+				quote = '\0';
+			} else if (quote == '\0' && (c == '\'' || c == '"')) {
+				quote = c;
+			} else if (c == '\\' && quote != '\'' && m_read + 1 < m_text.size() && (quote == '\0' || is_escapable(m_text[m_read + 1]))) {
+				m_text[write++] = m_text[++m_read];
+			} else {
+				m_text[write++] = c;
+			}
+		}
+
+		if (quote != '\0') {
+			m_malformed = true;
+			return false;
+		}
+		out = std::string_view{m_text.data() + start, write - start};
+		return true;
+	}
+
+	/// \brief Check if input ended inside a quoted section.
+	[[nodiscard]] constexpr auto is_malformed() const -> bool { return m_malformed; }
+
+  private:
+	static constexpr auto is_space(char const c) -> bool { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'; }
+	static constexpr auto is_escapable(char const c) -> bool { return c == '"' || c == '\\'; }
+
+	constexpr void skip_whitespace() {
+		while (m_read < m_text.size() && is_space(m_text[m_read])) { ++m_read; }
+	}
+
+	std::span<char> m_text{};
+	std::size_t m_read{};
+	bool m_malformed{};
+};
+} // namespace cliq
@@ -0,0 +1,87 @@
+#include <cliq/trace.hpp>
+#include <format>
+#include <iterator>
+
+namespace cliq {
+namespace {
+using Out = std::back_insert_iterator<std::pmr::string>;
+
+constexpr auto to_string(TokenType const type) -> std::string_view {
+	switch (type) {
+	case TokenType::Option: return "option";
+	case TokenType::Argument: return "argument";
+	case TokenType::ForceArgs: return "force_args";
+	default: return "none";
+	}
+}
+
+constexpr auto to_string(OptionType const type) -> std::string_view {
+	switch (type) {
+	case OptionType::Letters: return "letters";
+	case OptionType::Word: return "word";
+	default: return "none";
+	}
+}
+
+constexpr auto to_string(TraceOutcome const outcome) -> std::string_view {
+	switch (outcome) {
+	case TraceOutcome::Assigned: return "assigned";
+	case TraceOutcome::SelectedCommand: return "selected_command";
+	case TraceOutcome::ExecutedBuiltin: return "executed_builtin";
+	case TraceOutcome::Failed: return "failed";
+	default: return "none";
+	}
+}
+
+void append_json_string(Out out, std::string_view const text) {
+	*out++ = '"';
+	for (auto const c : text) {
+		switch (c) {
+		case '"': std::format_to(out, "\\\""); break;
+		case '\\': std::format_to(out, "\\\\"); break;
+		case '\n': std::format_to(out, "\\n"); break;
+		case '\r': std::format_to(out, "\\r"); break;
+		case '\t': std::format_to(out, "\\t"); break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				std::format_to(out, "\\u{:04x}", static_cast<unsigned char>(c));
+			} else {
+				*out++ = c;
+			}
+			break;
+		}
+	}
+	*out++ = '"';
+}
+
+void append_param(Out out, TraceEvent const& event) {
+	auto kind = std::string_view{};
+	auto name = std::string_view{};
+	if (event.command != nullptr) {
+		kind = "command";
+		name = event.command->name;
+	} else if (event.positional != nullptr) {
+		kind = "positional";
+		name = event.positional->name;
+	} else if (event.option != nullptr) {
+		kind = "option";
+		name = event.option->word.empty() ? std::string_view{&event.option->letter, 1} : event.option->word;
+	} else {
+		return;
+	}
+	std::format_to(out, R"(,"param":{{"kind":"{}","name":)", kind);
+	append_json_string(out, name);
+	*out++ = '}';
+}
+} // namespace
+
+void append_json_line(TraceEvent const& event, std::pmr::string& out) {
+	auto const it = std::back_inserter(out);
+	std::format_to(it, R"({{"index":{},"count":{},"input":)", event.index, event.count);
+	append_json_string(it, event.input);
+	std::format_to(it, R"(,"token_type":"{}","option_type":"{}")", to_string(event.token_type), to_string(event.option_type));
+	append_param(it, event);
+	std::format_to(it, R"(,"outcome":"{}","elapsed_ns":{}}})", to_string(event.outcome), event.elapsed.count());
+	out += '\n';
+}
+} // namespace cliq
@@ -0,0 +1,30 @@
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace cliq::test {
+/// \brief File in the temp directory holding text, removed on destruction.
+struct TempFile {
+	TempFile(TempFile const&) = delete;
+	TempFile(TempFile&&) = delete;
+	auto operator=(TempFile const&) = delete;
+	auto operator=(TempFile&&) = delete;
+
+	explicit TempFile(std::string_view const name, std::string_view const text)
+		: path(std::filesystem::temp_directory_path() / name), path_str(path.string()) {
+		auto file = std::ofstream{path, std::ios::binary};
+		file << text;
+	}
+
+	~TempFile() {
+		auto ec = std::error_code{};
+		std::filesystem::remove(path, ec);
+	}
+
+	std::filesystem::path path;
+	std::string path_str;
+};
+} // namespace cliq::test
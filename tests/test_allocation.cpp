@@ -0,0 +1,127 @@
+#include <cliq/parse.hpp>
+#include <ktest/ktest.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace {
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::uint64_t> g_allocations{};
+
+// std::aligned_alloc is not provided by MSVC, and its blocks must be released with _aligned_free.
+auto aligned_allocate(std::size_t const size, std::size_t const alignment) -> void* {
+#if defined(_WIN32)
+	return _aligned_malloc(size, alignment);
+#else
+	// size must be a multiple of alignment.
+	return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment); // NOLINT(cppcoreguidelines-no-malloc)
+#endif
+}
+
+void aligned_free(void* ptr) {
+#if defined(_WIN32)
+	_aligned_free(ptr);
+#else
+	std::free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+#endif
+}
+} // namespace
+
+auto operator new(std::size_t const size) -> void* {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ret = std::malloc(size == 0 ? 1 : size)) { return ret; } // NOLINT(cppcoreguidelines-no-malloc)
+	throw std::bad_alloc{};
+}
+
+auto operator new(std::size_t const size, std::align_val_t const align) -> void* {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ret = aligned_allocate(std::max(size, std::size_t{1}), std::max(std::size_t(align), sizeof(void*)))) { return ret; }
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); } // NOLINT(cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); } // NOLINT(cppcoreguidelines-no-malloc)
+void operator delete(void* ptr, std::align_val_t /*align*/) noexcept { aligned_free(ptr); }
+void operator delete(void* ptr, std::size_t /*size*/, std::align_val_t /*align*/) noexcept { aligned_free(ptr); }
+
+namespace {
+using namespace cliq;
+
+constexpr auto app_info_v = AppInfo{};
+
+TEST(allocation_none_on_success) {
+	static constexpr auto argv = std::array{"app", "-v", "--count=42", "--ratio", "0.5", "-n", "foo", "bar", "7"};
+	auto verbose = false;
+	auto count = 0;
+	auto ratio = 0.0f;
+	auto name = std::string_view{};
+	auto input = std::string_view{};
+	auto number = std::int64_t{};
+	auto const args = std::array{
+		flag(verbose, "v,verbose"),
+		option(count, "c,count"),
+		option(ratio, "ratio"),
+		option(name, "n,name"),
+		positional(input, ArgType::Required, "input"),
+		positional(number, ArgType::Optional, "number"),
+	};
+
+	auto buffer = std::array<std::byte, 4096>{};
+	auto arena = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+	auto const before = g_allocations.load();
+	auto const result = parse(app_info_v, args, int(argv.size()), argv.data(), ParseConfig{.resource = &arena});
+	auto const allocations = g_allocations.load() - before;
+
+	EXPECT(!result.early_return());
+	EXPECT(allocations == 0);
+	EXPECT(verbose && count == 42 && ratio == 0.5f && name == "foo" && input == "bar" && number == 7);
+}
+
+TEST(allocation_list_in_arena) {
+	static constexpr auto argv = std::array{"app", "1", "2", "3", "4", "5"};
+	auto buffer = std::array<std::byte, 4096>{};
+	auto arena = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+	auto numbers = std::pmr::vector<int>{&arena};
+	auto const args = std::array{list(numbers, "numbers")};
+
+	auto const before = g_allocations.load();
+	auto const result = parse(app_info_v, args, int(argv.size()), argv.data(), ParseConfig{.resource = &arena});
+	auto const allocations = g_allocations.load() - before;
+
+	EXPECT(!result.early_return());
+	EXPECT(allocations == 0);
+	EXPECT((numbers == std::pmr::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST(allocation_none_selecting_command) {
+	static constexpr auto argv = std::array{"app", "-v", "remote", "add", "--fetch", "origin"};
+	auto verbose = false;
+	auto fetch = false;
+	auto name = std::string_view{};
+	auto const add_args = std::array{
+		flag(fetch, "f,fetch"),
+		positional(name, ArgType::Required, "name"),
+	};
+	auto const remote_args = std::array{command(add_args, "add")};
+	auto const args = std::array{
+		flag(verbose, "v,verbose"),
+		command(remote_args, "remote"),
+	};
+
+	auto buffer = std::array<std::byte, 8192>{};
+	auto arena = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+	auto const before = g_allocations.load();
+	auto const result = parse(app_info_v, args, int(argv.size()), argv.data(), ParseConfig{.resource = &arena});
+	auto const allocations = g_allocations.load() - before;
+
+	EXPECT(!result.early_return());
+	EXPECT(allocations == 0);
+	EXPECT(result.get_command_name() == "add" && result.get_command_path().size() == 2);
+	EXPECT(verbose && fetch && name == "origin");
+}
+} // namespace
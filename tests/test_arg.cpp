@@ -1,6 +1,7 @@
 #include <cliq/arg.hpp>
 #include <ktest/ktest.hpp>
 #include <ranges>
+#include <vector>
 
 namespace {
 using namespace cliq;
@@ -91,6 +92,25 @@ TEST(arg_string) {
 	EXPECT(positional.assign("bar") && foo == "bar");
 }
 
+static_assert(Binding::create<bool>().type == BindingType::Bool);
+static_assert(Binding::create<std::string_view>().type == BindingType::StringView);
+static_assert(Binding::create<int>().type == BindingType::Int);
+static_assert(Binding::create<unsigned long long>().type == BindingType::UnsignedLongLong);
+static_assert(Binding::create<double>().type == BindingType::Double);
+static_assert(Binding::create<std::vector<int>>().type == BindingType::Custom);
+
+TEST(arg_binding_dispatch) {
+	auto const binding = Binding::create<short>();
+	short dispatched{};
+	short indirect{};
+	EXPECT(binding.dispatch_assign(&dispatched, "-42") && binding.assign(&indirect, "-42") && dispatched == indirect);
+	EXPECT(!binding.dispatch_assign(&dispatched, "40000") && !binding.assign(&indirect, "40000"));
+
+	auto const list_binding = Binding::create<std::vector<int>>();
+	auto list = std::vector<int>{};
+	EXPECT(list_binding.dispatch_assign(&list, "1") && list.size() == 1);
+}
+
 TEST(arg_command) {
 	struct CmdParams {
 		bool verbose{};
@@ -108,4 +128,35 @@ TEST(arg_command) {
 	EXPECT(cmd.name == "cmd");
 	for (auto const& [a, b] : std::ranges::zip_view(cmd.args, args)) { EXPECT(a.get_param().index() == b.get_param().index()); }
 }
+
+namespace static_args {
+bool verbose{};
+int count{};
+std::string_view name{};
+
+constexpr auto cmd_args_v = std::array{
+	flag(verbose, "v,verbose"),
+	positional(name, ArgType::Required, "name"),
+};
+
+constexpr auto args_v = std::array{
+	flag(verbose, "v,verbose"),
+	option(count, "c,count"),
+	command(cmd_args_v, "count"),
+};
+static_assert(has_unique_keys(args_v));
+
+constexpr auto dup_letter_v = std::array{flag(verbose, "v,verbose"), option(count, "v,value")};
+static_assert(!has_unique_keys(dup_letter_v));
+
+constexpr auto dup_word_v = std::array{flag(verbose, "verbose"), option(count, "c,verbose")};
+static_assert(!has_unique_keys(dup_word_v));
+
+constexpr auto dup_builtin_v = std::array{flag(verbose, "help")};
+static_assert(!has_unique_keys(dup_builtin_v));
+
+constexpr auto dup_nested_v = std::array{flag(verbose, "v,verbose"), option(count, "v,value")};
+constexpr auto nested_v = std::array{command(dup_nested_v, "cmd")};
+static_assert(!has_unique_keys(nested_v));
+} // namespace static_args
 } // namespace
@@ -0,0 +1,126 @@
+#include <cliq/compiled_parser.hpp>
+#include <ktest/ktest.hpp>
+#include <array>
+
+namespace {
+using namespace cliq;
+
+constexpr auto app_info_v = AppInfo{};
+
+TEST(compiled_parser_reuse) {
+	auto verbose = false;
+	auto count = 10;
+	auto name = std::string{"default"};
+	auto inputs = std::vector<int>{};
+	auto const args = std::array{
+		flag(verbose, "v,verbose"),
+		option(count, "c,count"),
+		option(name, "n,name"),
+		list(inputs, "inputs"),
+	};
+	auto parser = CompiledParser{app_info_v, args, "app"};
+
+	auto result = parser.parse(std::array{"-v", "--count=42", "-n", "foo", "1", "2", "3"});
+	EXPECT(!result.early_return());
+	EXPECT(verbose && count == 42 && name == "foo");
+	EXPECT((inputs == std::vector<int>{1, 2, 3}));
+
+	result = parser.parse(std::array{"4", "5"});
+	EXPECT(!result.early_return());
+	EXPECT(!verbose && count == 10 && name == "default");
+	EXPECT((inputs == std::vector<int>{4, 5}));
+
+	result = parser.parse(std::array{"-c", "abc"});
+	EXPECT(result.get_parse_error() == ParseError::InvalidArgument);
+
+	parser.reset();
+	EXPECT(count == 10 && inputs.empty());
+}
+
+TEST(compiled_parser_commands) {
+	auto app_flag = false;
+	auto cmd_flag = false;
+	auto cmd_arg = std::string_view{};
+	auto const cmd_args = std::array{
+		flag(cmd_flag, "f,flag"),
+		positional(cmd_arg, ArgType::Required, "arg"),
+	};
+	auto const args = std::array{
+		flag(app_flag, "a,app"),
+		command(cmd_args, "zeta"),
+		command(cmd_args, "alpha"),
+	};
+	auto parser = CompiledParser{app_info_v, args, "app"};
+
+	auto result = parser.parse(std::array{"-a", "zeta", "-f", "foo"});
+	EXPECT(!result.early_return());
+	EXPECT(result.get_command_name() == "zeta");
+	EXPECT(app_flag && cmd_flag && cmd_arg == "foo");
+
+	result = parser.parse(std::array{"alpha", "bar"});
+	EXPECT(!result.early_return());
+	EXPECT(result.get_command_name() == "alpha");
+	EXPECT(!app_flag && !cmd_flag && cmd_arg == "bar");
+}
+
+TEST(compiled_parser_reset_lists) {
+	auto inputs = std::vector<int>{};
+	auto const args = std::array{list(inputs, "inputs")};
+	auto parser = CompiledParser{app_info_v, args, "app"};
+	EXPECT(!parser.parse(std::array{"1", "2", "3", "4"}).early_return());
+	auto const* data = inputs.data();
+	// a list that started empty is cleared, so its storage is reused.
+	EXPECT(!parser.parse(std::array{"5", "6"}).early_return());
+	EXPECT(inputs.data() == data && (inputs == std::vector<int>{5, 6}));
+
+	auto defaults = std::vector<int>{7};
+	auto const default_args = std::array{list(defaults, "inputs")};
+	auto default_parser = CompiledParser{app_info_v, default_args, "app"};
+	EXPECT(!default_parser.parse(std::array{"8"}).early_return());
+	EXPECT((defaults == std::vector<int>{7, 8}));
+	default_parser.reset();
+	EXPECT((defaults == std::vector<int>{7}));
+}
+
+TEST(compiled_parser_nested_commands) {
+	auto force = false;
+	auto const drain_args = std::array{flag(force, "f,force")};
+	auto const node_args = std::array{command(drain_args, "drain")};
+	auto const args = std::array{command(node_args, "node")};
+	auto parser = CompiledParser{app_info_v, args, "app"};
+
+	auto result = parser.parse(std::array{"node", "drain", "-f"});
+	EXPECT(!result.early_return());
+	EXPECT(force);
+	EXPECT(result.get_command_path().size() == 2);
+	EXPECT(result.get_command_name() == "drain");
+
+	result = parser.parse(std::array{"node", "drian"});
+	EXPECT(result.get_parse_error() == ParseError::InvalidCommand);
+	EXPECT(result.get_suggestion() == "drain");
+}
+
+TEST(compiled_parser_line) {
+	auto count = 0;
+	auto name = std::string_view{};
+	auto const args = std::array{
+		option(count, "c,count"),
+		positional(name, ArgType::Required, "name"),
+	};
+	auto parser = CompiledParser{app_info_v, args, "app"};
+
+	auto line = std::string{R"(-c 42 "hello world")"};
+	auto result = parser.parse_line(line);
+	EXPECT(!result.early_return());
+	EXPECT(count == 42 && name == "hello world");
+
+	line = R"(--count=7 'it''s')";
+	result = parser.parse_line(line);
+	EXPECT(!result.early_return());
+	EXPECT(count == 7 && name == "its");
+
+	line = "'unterminated";
+	result = parser.parse_line(line);
+	EXPECT(result.get_parse_error() == ParseError::InvalidArgument);
+}
+} // namespace
@@ -0,0 +1,105 @@
+#include <completion.hpp>
+#include <ktest/ktest.hpp>
+#include <array>
+
+namespace {
+using namespace cliq;
+
+TEST(completion_matches) {
+	bool verbose{};
+	bool force{};
+	int count{};
+	auto const cmd_args = std::array{Arg{force, "f,force"}};
+	auto const args = std::array{
+		Arg{verbose, "v,verbose"},
+		Arg{count, "c,count"},
+		Arg{cmd_args, "create"},
+		Arg{cmd_args, "clean"},
+		Arg{cmd_args, "remove"},
+	};
+	auto const tree = CommandTree{args, *std::pmr::get_default_resource()};
+	auto const matches = [&tree](auto const&... words) {
+		auto const input = std::array<std::string_view, sizeof...(words)>{words...};
+		return format_matches(tree, input);
+	};
+
+	EXPECT(matches("") == "clean\ncreate\nremove\n");
+	EXPECT(matches("c") == "clean\ncreate\n");
+	EXPECT(matches("cr") == "create\n");
+	EXPECT(matches("--co") == "--count\n--completions\n");
+	EXPECT(matches("--ver") == "--verbose\n--version\n");
+	EXPECT(matches("-") == "-v\n-c\n--count\n--verbose\n--help\n--usage\n--version\n--completions\n");
+	EXPECT(matches("--count", "").empty());
+	EXPECT(matches("-c", "").empty());
+	EXPECT(matches("-v", "cl") == "clean\n");
+	EXPECT(matches("clean", "--f") == "--force\n");
+	EXPECT(matches("clean", "").empty());
+	EXPECT(matches("unknown", "--f").empty());
+	EXPECT(matches("--", "--v").empty());
+}
+
+TEST(completion_nested) {
+	bool force{};
+	auto const drain_args = std::array{Arg{force, "f,force"}};
+	auto const node_args = std::array{Arg{drain_args, "drain"}, Arg{drain_args, "describe"}};
+	auto const cluster_args = std::array{Arg{node_args, "node"}};
+	auto const args = std::array{Arg{cluster_args, "cluster"}};
+	auto const tree = CommandTree{args, *std::pmr::get_default_resource()};
+	auto const matches = [&tree](auto const&... words) {
+		auto const input = std::array<std::string_view, sizeof...(words)>{words...};
+		return format_matches(tree, input);
+	};
+
+	EXPECT(matches("cluster", "") == "node\n");
+	EXPECT(matches("cluster", "node", "d") == "describe\ndrain\n");
+	EXPECT(matches("cluster", "node", "drain", "--") == "--force\n--help\n--usage\n--version\n--completions\n");
+
+	auto const bash = format_completions(Shell::Bash, "tool", args);
+	EXPECT(bash.contains("'/cluster'|'/cluster/node'|'/cluster/node/drain'|'/cluster/node/describe')"));
+	EXPECT(bash.contains("'/cluster/node') words+=( 'drain' 'describe')"));
+}
+
+TEST(completion_globals) {
+	bool verbose{};
+	bool force{};
+	auto const cmd_args = std::array{Arg{force, "f,force"}};
+	auto const args = std::array{Arg{verbose, "v,verbose"}.as_global(), Arg{cmd_args, "clean"}};
+	auto const tree = CommandTree{args, *std::pmr::get_default_resource()};
+	auto const input = std::array<std::string_view, 2>{"clean", "-"};
+	EXPECT(format_matches(tree, input) == "-f\n-v\n--force\n--verbose\n--help\n--usage\n--version\n--completions\n");
+
+	auto const bash = format_completions(Shell::Bash, "tool", args);
+	EXPECT(bash.contains("local -a words=(--help --usage --version --completions '--verbose' '-v')"));
+	EXPECT(bash.contains("*) words+=( 'clean')"));
+
+	auto const fish = format_completions(Shell::Fish, "tool", args);
+	EXPECT(fish.contains("complete -c tool -s v -l 'verbose'\n"));
+}
+
+TEST(completion_scripts) {
+	bool verbose{};
+	auto const cmd_args = std::array{Arg{verbose, "f,force", "don't ask"}};
+	auto const args = std::array{
+		Arg{verbose, "v,verbose"},
+		Arg{cmd_args, "clean"},
+	};
+
+	EXPECT(to_shell("bash") == Shell::Bash);
+	EXPECT(to_shell("zsh") == Shell::Zsh);
+	EXPECT(to_shell("fish") == Shell::Fish);
+	EXPECT(!to_shell("tcsh"));
+
+	auto const bash = format_completions(Shell::Bash, "my-app", args);
+	EXPECT(bash.contains("complete -o default -F _cliq_my_app my-app"));
+	EXPECT(bash.contains("'/clean') words+=( '--force' '-f')"));
+
+	auto const zsh = format_completions(Shell::Zsh, "my-app", args);
+	EXPECT(zsh.starts_with("#compdef my-app\n"));
+	EXPECT(zsh.contains("compdef _cliq_my_app my-app"));
+
+	auto const fish = format_completions(Shell::Fish, "my-app", args);
+	EXPECT(fish.contains("complete -c my-app -n '__cliq_my_app_at \\'\\'' -s v -l 'verbose'\n"));
+	EXPECT(fish.contains("complete -c my-app -n '__cliq_my_app_at \\'\\'' -f -a 'clean'\n"));
+	EXPECT(fish.contains("complete -c my-app -n '__cliq_my_app_at \\'/clean\\'' -s f -l 'force' -d 'don\\'t ask'\n"));
+}
+} // namespace
@@ -0,0 +1,78 @@
+#include <diagnostic.hpp>
+#include <ktest/ktest.hpp>
+#include <parser.hpp>
+#include <array>
+
+namespace {
+using namespace cliq;
+
+constexpr auto app_info_v = AppInfo{};
+constexpr auto quiet_v = ParseConfig{.print_errors = false};
+
+TEST(diagnostic_unrecognized_option) {
+	static constexpr auto cli_args = std::array{"-v", "--vrebose"};
+	bool verbose{};
+	auto const args = std::array{Arg{verbose, "v,verbose"}};
+	auto parser = Parser{app_info_v, "app", cli_args, quiet_v};
+	auto const result = parser.parse(args);
+	EXPECT(result.get_parse_error() == ParseError::InvalidOption);
+	auto const& diagnostic = result.get_diagnostic();
+	EXPECT(diagnostic.kind == DiagnosticKind::UnrecognizedOption);
+	EXPECT(diagnostic.index == 1);
+	EXPECT(diagnostic.input == "vrebose");
+	EXPECT(diagnostic.input.data() == cli_args[1] + 2);
+	EXPECT(diagnostic.candidates[0] == "verbose");
+	EXPECT(format_diagnostic(diagnostic) == "app: unrecognized option '--vrebose'\nDid you mean '--verbose'?\nTry 'app --help' for more information.\n");
+}
+
+TEST(diagnostic_invalid_value) {
+	static constexpr auto cli_args = std::array{"cmd", "-fc", "x"};
+	bool force{};
+	int count{};
+	auto const cmd_args = std::array{Arg{force, "f,force"}, Arg{count, "c,count"}};
+	auto const args = std::array{Arg{cmd_args, "cmd"}};
+	auto parser = Parser{app_info_v, "app", cli_args, quiet_v};
+	auto const result = parser.parse(args);
+	EXPECT(result.get_parse_error() == ParseError::InvalidArgument);
+	auto const& diagnostic = result.get_diagnostic();
+	EXPECT(diagnostic.kind == DiagnosticKind::InvalidValue);
+	EXPECT(diagnostic.index == 2);
+	EXPECT(diagnostic.command == "cmd");
+	EXPECT(diagnostic.input == "c");
+	EXPECT(diagnostic.input.data() == cli_args[1] + 2);
+	EXPECT(diagnostic.value == "x");
+	EXPECT(format_diagnostic(diagnostic) == "app cmd: invalid c: 'x'\n");
+}
+
+TEST(diagnostic_ambiguous_option) {
+	static constexpr auto cli_args = std::array{"--ver"};
+	bool verbose{};
+	bool verify{};
+	bool vertical{};
+	auto const args = std::array{Arg{verbose, "verbose"}, Arg{verify, "verify"}, Arg{vertical, "vertical"}};
+	auto parser = Parser{app_info_v, "app", cli_args, quiet_v};
+	auto const result = parser.parse(args);
+	EXPECT(result.get_parse_error() == ParseError::AmbiguousOption);
+	auto const& diagnostic = result.get_diagnostic();
+	EXPECT(diagnostic.input == "ver");
+	EXPECT((diagnostic.candidates == std::array<std::string_view, 2>{"verbose", "verify"}));
+	EXPECT(format_diagnostic(diagnostic).starts_with("app: option '--ver' is ambiguous; possibilities include '--verbose' '--verify'\n"));
+
+	static constexpr auto possibilities = std::array<std::string_view, 3>{"verbose", "verify", "vertical"};
+	auto const full = format_diagnostic(diagnostic, possibilities, *std::pmr::get_default_resource());
+	EXPECT(full.starts_with("app: option '--ver' is ambiguous; possibilities: '--verbose' '--verify' '--vertical'\n"));
+}
+
+TEST(diagnostic_missing_argument) {
+	bool verbose{};
+	auto const cmd_args = std::array{Arg{verbose, "verbose"}};
+	auto const args = std::array{Arg{cmd_args, "cmd"}};
+	auto parser = Parser{app_info_v, "app", {}, quiet_v};
+	auto const result = parser.parse(args);
+	EXPECT(result.get_parse_error() == ParseError::MissingArgument);
+	EXPECT(result.get_diagnostic().kind == DiagnosticKind::MissingArgument);
+	EXPECT(result.get_diagnostic().index == std::string_view::npos);
+	EXPECT(result.get_diagnostic().input == "command");
+	EXPECT(format_diagnostic(Diagnostic{}).empty());
+}
+} // namespace
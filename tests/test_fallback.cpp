@@ -0,0 +1,70 @@
+#include <cliq/parse.hpp>
+#include <ktest/ktest.hpp>
+#include <temp_file.hpp>
+#include <array>
+
+namespace {
+using namespace cliq;
+using cliq::test::TempFile;
+
+constexpr auto app_info_v = AppInfo{};
+
+struct Params {
+	int threads{};
+	std::string_view name{"default"};
+	bool verbose{};
+	int depth{};
+
+	[[nodiscard]] auto get_args() -> std::array<Arg, 4> {
+		return {
+			option(threads, "t,threads").with_env("APP_THREADS").with_config("threads"),
+			option(name, "name").with_config("name"),
+			flag(verbose, "v,verbose").with_env("APP_VERBOSE"),
+			option(depth, "depth"),
+		};
+	}
+};
+
+TEST(fallback_env) {
+	static constexpr auto environment = std::array<char const*, 4>{"PATH=/bin", "APP_THREADS=8", "APP_VERBOSE=1", nullptr};
+	auto const config = ParseConfig{.environment = environment.data()};
+
+	auto params = Params{};
+	auto const args = params.get_args();
+	auto const argv = std::array{"app"};
+	EXPECT(!parse(app_info_v, args, int(argv.size()), argv.data(), config).early_return());
+	EXPECT(params.threads == 8 && params.verbose && params.name == "default");
+
+	params = Params{};
+	auto const argv_threads = std::array{"app", "-t", "2"};
+	EXPECT(!parse(app_info_v, args, int(argv_threads.size()), argv_threads.data(), config).early_return());
+	EXPECT(params.threads == 2 && params.verbose);
+}
+
+TEST(fallback_config) {
+	auto const file = TempFile{"cliq_test_fallback.cfg", "# comment\n\n  threads = 4 \nname=from config\r\ndepth = 9\nbogus line\n"};
+	static constexpr auto environment = std::array<char const*, 2>{"APP_VERBOSE=0", nullptr};
+	auto const config = ParseConfig{.environment = environment.data(), .config_file = file.path_str.c_str()};
+
+	auto params = Params{};
+	auto const args = params.get_args();
+	auto const argv = std::array{"app"};
+	auto const result = parse(app_info_v, args, int(argv.size()), argv.data(), config);
+	EXPECT(!result.early_return());
+	EXPECT(params.threads == 4 && params.name == "from config" && !params.verbose && params.depth == 0);
+
+	auto const missing = ParseConfig{.environment = environment.data(), .config_file = "/does/not/exist.cfg"};
+	params = Params{};
+	EXPECT(!parse(app_info_v, args, int(argv.size()), argv.data(), missing).early_return());
+	EXPECT(params.threads == 0);
+}
+
+TEST(fallback_invalid) {
+	static constexpr auto environment = std::array<char const*, 2>{"APP_THREADS=lots", nullptr};
+	auto const config = ParseConfig{.environment = environment.data()};
+	auto params = Params{};
+	auto const args = params.get_args();
+	auto const argv = std::array{"app"};
+	EXPECT(parse(app_info_v, args, int(argv.size()), argv.data(), config).get_return_code() == int(ParseError::InvalidArgument));
+}
+} // namespace
@@ -0,0 +1,139 @@
+#include <cliq/parse.hpp>
+#include <ktest/ktest.hpp>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// only GNU getopt_long resets fully on optind = 0 and permutes like cliq (BSD / musl differ): __GLIBC__ comes with the headers above.
+#if defined(__GLIBC__)
+#include <getopt.h>
+
+namespace {
+/// \brief Outputs of one parse, by either parser. Values are left empty if parsing failed.
+struct Parsed {
+	bool ok{};
+	bool alpha{};
+	bool beta{};
+	bool verbose{};
+	std::string_view count{};
+	std::string_view name{};
+	std::vector<std::string_view> inputs{};
+
+	auto operator==(Parsed const&) const -> bool = default;
+};
+
+constexpr auto app_info_v = cliq::AppInfo{};
+
+auto parse_cliq(std::span<char const* const> argv) -> Parsed {
+	auto ret = Parsed{};
+	auto const args = std::array{
+		cliq::Arg{ret.alpha, "a,alpha"},
+		cliq::Arg{ret.beta, "b,beta"},
+		cliq::Arg{ret.verbose, "verbose"},
+		cliq::Arg{ret.count, "c,count"},
+		cliq::Arg{ret.name, "name"},
+		cliq::Arg{ret.inputs, "inputs"},
+	};
+	auto const result = cliq::parse(app_info_v, args, int(argv.size()), argv.data(), cliq::ParseConfig{.print_errors = false});
+	if (result.early_return()) { return {}; }
+	ret.ok = true;
+	return ret;
+}
+
+// GNU getopt_long with the same schema: permutes non-options to the end, accepts unambiguous long prefixes.
+auto parse_getopt(std::span<char const* const> argv) -> Parsed {
+	enum : int { Verbose = 256, Name };
+	static constexpr auto long_options_v = std::array<::option, 6>{{
+		{"alpha", no_argument, nullptr, 'a'},
+		{"beta", no_argument, nullptr, 'b'},
+		{"verbose", no_argument, nullptr, Verbose},
+		{"count", required_argument, nullptr, 'c'},
+		{"name", required_argument, nullptr, Name},
+		{nullptr, 0, nullptr, 0},
+	}};
+
+	auto mutable_argv = std::vector<char*>{};
+	for (auto const* arg : argv) { mutable_argv.push_back(const_cast<char*>(arg)); } // NOLINT(cppcoreguidelines-pro-type-const-cast)
+	mutable_argv.push_back(nullptr);
+	optind = 0; // full reinitialization (GNU)
+	opterr = 0;
+
+	auto ret = Parsed{.ok = true};
+	for (auto c = 0; (c = getopt_long(int(argv.size()), mutable_argv.data(), "abc:", long_options_v.data(), nullptr)) != -1;) {
+		switch (c) {
+		case 'a': ret.alpha = true; break;
+		case 'b': ret.beta = true; break;
+		case Verbose: ret.verbose = true; break;
+		case 'c': ret.count = optarg; break;
+		case Name: ret.name = optarg; break;
+		default: return {};
+		}
+	}
+	for (auto i = std::size_t(optind); i < argv.size(); ++i) { ret.inputs.emplace_back(mutable_argv[i]); }
+	return ret;
+}
+
+/// \brief Random command lines within the subset both parsers treat alike.
+/// Excluded: attached short values (-c42), empty "=" values, option-like values, and a trailing option missing its value.
+class Generator {
+  public:
+	explicit Generator(std::uint32_t const seed) : m_engine(seed) {}
+
+	auto make_argv() -> std::vector<char const*> {
+		auto ret = std::vector<char const*>{"app"};
+		auto const count = pick(12);
+		for (auto i = std::size_t{}; i < count; ++i) {
+			auto const choice = pick(5);
+			if (choice == 0) {
+				ret.push_back(flags_v[pick(flags_v.size())]);
+			} else if (choice == 1) {
+				ret.push_back(valued_v[pick(valued_v.size())]);
+				ret.push_back(values_v[pick(values_v.size())]);
+			} else if (choice == 2) {
+				ret.push_back(attached_v[pick(attached_v.size())]);
+			} else if (choice == 3) {
+				ret.push_back(values_v[pick(values_v.size())]);
+			} else {
+				ret.push_back(errors_v[pick(errors_v.size())]);
+			}
+		}
+		return ret;
+	}
+
+  private:
+	static constexpr auto flags_v = std::array{"-a", "-b", "-ab", "-ba", "--alpha", "--beta", "--verbose", "--al", "--b", "--verb", "--", "-"};
+	static constexpr auto valued_v = std::array{"-c", "-ac", "-bac", "--count", "--cou", "--name", "--na"};
+	static constexpr auto attached_v = std::array{"--count=1", "--name=x y", "--co=2", "--name=-a"};
+	static constexpr auto values_v = std::array{"x", "42", "-", "", "a b"};
+	static constexpr auto errors_v = std::array{"-z", "-az", "--zeta", "--alpha=1"};
+
+	auto pick(std::size_t const count) -> std::size_t { return std::uniform_int_distribution<std::size_t>{0, count - 1}(m_engine); }
+
+	std::mt19937 m_engine;
+};
+
+TEST(getopt_differential) {
+	auto generator = Generator{20'240'613};
+	auto mismatches = 0;
+	for (auto i = 0; i < 5'000; ++i) {
+		auto const argv = generator.make_argv();
+		if (parse_cliq(argv) != parse_getopt(argv)) { ++mismatches; }
+	}
+	EXPECT(mismatches == 0);
+}
+
+TEST(getopt_long_tokens) {
+	// a single huge token of letters, and many short ones: both must stay linear (and agree).
+	auto letters = std::string{"-"};
+	for (auto i = 0; i < 50'000; ++i) { letters += "ab"; }
+	auto argv = std::vector<char const*>{"app", letters.c_str()};
+	for (auto i = 0; i < 50'000; ++i) { argv.push_back(i % 2 == 0 ? "--al" : "x"); }
+	auto const parsed = parse_cliq(argv);
+	EXPECT(parsed.ok && parsed.alpha && parsed.beta && parsed.inputs.size() == 25'000);
+	EXPECT(parsed == parse_getopt(argv));
+}
+} // namespace
+#endif
@@ -0,0 +1,144 @@
+#include <ktest/ktest.hpp>
+#include <lookup.hpp>
+#include <array>
+
+namespace {
+using namespace cliq;
+
+TEST(lookup_options) {
+	bool verbose{};
+	int count{};
+	std::string_view name{};
+	auto const args = std::array{
+		Arg{verbose, "v,verbose"},
+		Arg{count, "c,count"},
+		Arg{name, "name"},
+		Arg{name, ArgType::Optional, "NAME"},
+	};
+	auto const lookup = Lookup{args};
+	EXPECT(!lookup.has_commands());
+	EXPECT(lookup.get_args().size() == args.size());
+
+	auto const* option = lookup.find_option('v');
+	ASSERT(option != nullptr);
+	EXPECT(option->word == "verbose");
+	EXPECT(lookup.find_option("verbose") == option);
+	EXPECT(lookup.find_option('c') == lookup.find_option("count"));
+	EXPECT(lookup.find_option("name") != nullptr);
+	EXPECT(lookup.find_option('n') == nullptr);
+	EXPECT(lookup.find_option('\0') == nullptr);
+	EXPECT(lookup.find_option("NAME") == nullptr);
+	EXPECT(lookup.find_option("verb") == nullptr);
+	EXPECT(lookup.find_command("verbose") == nullptr);
+}
+
+TEST(lookup_duplicates) {
+	int first{};
+	int second{};
+	auto const args = std::array{
+		Arg{first, "x,value"},
+		Arg{second, "x,value"},
+	};
+	auto const lookup = Lookup{args};
+	auto const* option = lookup.find_option('x');
+	ASSERT(option != nullptr);
+	EXPECT(option->data == &first);
+	EXPECT(lookup.find_option("value") == option);
+}
+
+TEST(lookup_commands) {
+	bool flag{};
+	auto const cmd_args = std::array{Arg{flag, "f,flag"}};
+	auto const args = std::array{
+		Arg{flag, "a,app"},
+		Arg{cmd_args, "zeta"},
+		Arg{cmd_args, "alpha"},
+	};
+	auto const lookup = Lookup{args};
+	EXPECT(lookup.has_commands());
+	auto const* alpha = lookup.find_command("alpha");
+	ASSERT(alpha != nullptr);
+	EXPECT(alpha->name == "alpha");
+	auto const* zeta = lookup.find_command("zeta");
+	ASSERT(zeta != nullptr);
+	EXPECT(zeta->args.data() == cmd_args.data());
+	EXPECT(lookup.find_command("app") == nullptr);
+	EXPECT(lookup.find_option('f') == nullptr);
+}
+
+TEST(lookup_help_layout) {
+	bool flag{};
+	std::string_view name{};
+	auto const cmd_args = std::array{Arg{flag, "f,flag"}};
+	auto const args = std::array{
+		Arg{flag, "a,a-rather-long-option"},
+		Arg{cmd_args, "command"},
+	};
+	auto const lookup = Lookup{args};
+	auto const& layout = lookup.get_help_layout();
+	EXPECT(layout.has_options);
+	EXPECT(!layout.has_positionals);
+	EXPECT(layout.options_width == std::string_view{"a-rather-long-option"}.size() + 6);
+	EXPECT(layout.commands_width == std::string_view{"command"}.size());
+
+	auto const pos_args = std::array{Arg{name, ArgType::Required, "NAME"}};
+	auto const pos_lookup = Lookup{pos_args};
+	auto const& pos_layout = pos_lookup.get_help_layout();
+	EXPECT(!pos_layout.has_options);
+	EXPECT(pos_layout.has_positionals);
+	EXPECT(pos_layout.options_width == std::string_view{"___--completions"}.size());
+	EXPECT(pos_layout.commands_width == 0);
+}
+
+TEST(lookup_abbreviations) {
+	bool flag{};
+	auto const args = std::array{
+		Arg{flag, "verbose"},
+		Arg{flag, "version-check"},
+		Arg{flag, "all"},
+		Arg{flag, "all-files"},
+	};
+	auto const lookup = Lookup{args};
+	auto matches = lookup.match_option("verb");
+	ASSERT(matches.size() == 1);
+	EXPECT(matches.front().key == "verbose");
+	EXPECT(lookup.match_option("ver").size() == 2);
+	EXPECT(lookup.match_option("all").size() == 1);
+	EXPECT(lookup.match_option("all-").front().key == "all-files");
+	EXPECT(lookup.match_option("x").empty());
+	EXPECT(lookup.match_option("").empty());
+}
+
+TEST(lookup_globals) {
+	bool verbose{};
+	bool quiet{};
+	int depth{};
+	bool force{};
+	auto const root_args = std::array{
+		flag(verbose, "v,verbose").as_global(),
+		flag(quiet, "q,quiet").as_global(),
+		option(depth, "depth"),
+	};
+	auto const cmd_args = std::array{
+		flag(force, "f,force"),
+		flag(force, "quiet"),
+	};
+	auto const root = Lookup{root_args};
+	ASSERT(root.get_globals().size() == 2);
+	EXPECT(root.get_inherited().empty());
+
+	auto const cmd = Lookup{cmd_args, *std::pmr::get_default_resource(), root.get_globals()};
+	EXPECT(cmd.find_option('v') == root.find_option('v'));
+	EXPECT(cmd.find_option("verbose") == root.find_option('v'));
+	EXPECT(cmd.match_option("verb").size() == 1);
+	// shadowed by the command's own "quiet", including its letter.
+	EXPECT(cmd.find_option("quiet") == std::get_if<ParamOption>(&cmd_args[1].get_param()));
+	EXPECT(cmd.find_option('q') == nullptr);
+	// not global.
+	EXPECT(cmd.find_option("depth") == nullptr);
+	ASSERT(cmd.get_inherited().size() == 1);
+	EXPECT(cmd.get_inherited().front()->word == "verbose");
+	EXPECT(cmd.get_globals().size() == 1);
+	EXPECT(cmd.get_help_layout().has_options);
+}
+} // namespace
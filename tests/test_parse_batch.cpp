@@ -0,0 +1,94 @@
+#include <cliq/parse_batch.hpp>
+#include <ktest/ktest.hpp>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace cliq;
+
+constexpr auto app_info_v = AppInfo{};
+
+struct Job {
+	bool verbose{};
+	int count{1};
+	std::string_view name{};
+
+	static auto bind(Job& job) {
+		return std::array{
+			flag(job.verbose, "v,verbose"),
+			option(job.count, "c,count"),
+			positional(job.name, ArgType::Required, "name"),
+		};
+	}
+};
+
+TEST(parse_batch_slots) {
+	static constexpr auto a_v = std::array{"-v", "a"};
+	static constexpr auto b_v = std::array{"--count=3", "b"};
+	static constexpr auto c_v = std::array{"-c", "x", "c"};
+	auto const jobs = std::array<std::span<char const* const>, 3>{a_v, b_v, c_v};
+	auto slots = std::array<Job, 3>{};
+
+	auto const results = parse_batch(app_info_v, jobs, std::span{slots}, &Job::bind);
+	ASSERT(results.size() == 3);
+	EXPECT(!results[0].early_return() && !results[1].early_return());
+	EXPECT(slots[0].verbose && slots[0].count == 1 && slots[0].name == "a");
+	// outputs are reset between command lines.
+	EXPECT(!slots[1].verbose && slots[1].count == 3 && slots[1].name == "b");
+	EXPECT(results[2].get_parse_error() == ParseError::InvalidArgument);
+	EXPECT(results[2].get_diagnostic().value == "x");
+}
+
+TEST(parse_batch_threads) {
+	auto storage = std::vector<std::array<std::string, 2>>{};
+	for (auto i = 0; i < 1000; ++i) { storage.push_back({"--count=" + std::to_string(i), "job" + std::to_string(i)}); }
+	auto argvs = std::vector<std::array<char const*, 2>>{};
+	for (auto const& job : storage) { argvs.push_back({job[0].c_str(), job[1].c_str()}); }
+	auto jobs = std::vector<std::span<char const* const>>{};
+	for (auto const& argv : argvs) { jobs.emplace_back(argv); }
+	auto slots = std::vector<Job>(jobs.size());
+
+	auto const results = parse_batch(app_info_v, jobs, slots, &Job::bind, BatchConfig{.threads = 4});
+	ASSERT(results.size() == jobs.size());
+	auto ok = true;
+	for (auto i = std::size_t{}; i < slots.size(); ++i) {
+		ok = ok && !results[i].early_return() && slots[i].count == int(i) && slots[i].name == storage[i][1];
+	}
+	EXPECT(ok);
+}
+
+/// \brief Converts like int, but throws on an invalid value (as a custom conversion might).
+struct Checked {
+	int value{};
+
+	friend auto cliq_assign(Checked& out, std::string_view const value) -> bool {
+		if (!parse_number(value, out.value)) { throw std::invalid_argument{std::string{value}}; }
+		return true;
+	}
+};
+
+struct CheckedJob {
+	Checked checked{};
+
+	static auto bind(CheckedJob& job) { return std::array{positional(job.checked, ArgType::Required, "value")}; }
+};
+
+TEST(parse_batch_rethrows) {
+	auto storage = std::vector<std::string>{};
+	for (auto i = 0; i < 100; ++i) { storage.push_back(i == 50 ? "x" : std::to_string(i)); }
+	auto argvs = std::vector<std::array<char const*, 1>>{};
+	for (auto const& str : storage) { argvs.push_back({str.c_str()}); }
+	auto jobs = std::vector<std::span<char const* const>>{};
+	for (auto const& argv : argvs) { jobs.emplace_back(argv); }
+	auto slots = std::vector<CheckedJob>(jobs.size());
+
+	// thrown on a worker (or the calling thread), and rethrown on the calling thread once all have finished.
+	auto thrown = std::string{};
+	try {
+		[[maybe_unused]] auto const results = parse_batch(app_info_v, jobs, slots, &CheckedJob::bind, BatchConfig{.threads = 4});
+	} catch (std::invalid_argument const& e) { thrown = e.what(); }
+	EXPECT(thrown == "x");
+}
+} // namespace
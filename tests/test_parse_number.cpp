@@ -0,0 +1,54 @@
+#include <cliq/parse_number.hpp>
+#include <ktest/ktest.hpp>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace {
+using namespace cliq;
+
+template <typename Type>
+auto matches_from_chars(std::string_view const value) -> bool {
+	auto expected = Type{};
+	auto const* last = value.data() + value.size();
+	auto const [ptr, ec] = std::from_chars(value.data(), last, expected);
+	auto const expected_ok = ptr == last && ec == std::errc{};
+	auto actual = Type{};
+	if (parse_number(value, actual) != expected_ok) { return false; }
+	return !expected_ok || actual == expected;
+}
+
+template <typename Type>
+auto matches_all(std::span<std::string_view const> values) -> bool {
+	return std::ranges::all_of(values, [](std::string_view const value) { return matches_from_chars<Type>(value); });
+}
+
+constexpr auto inputs_v = std::array<std::string_view, 26>{
+	"0", "7", "-7", "42", "-128", "255", "256", "-0", "12345678", "87654321", "123456789", "-123456789", "2147483647",
+	"2147483648", "-2147483648", "4294967296", "0012345678", "9223372036854775807", "", "-", "+1", "1a", "12345678a", "1234567a8", " 1", "3.14",
+};
+
+TEST(parse_number_matches_from_chars) {
+	EXPECT(matches_all<std::int8_t>(inputs_v));
+	EXPECT(matches_all<std::uint8_t>(inputs_v));
+	EXPECT(matches_all<std::int32_t>(inputs_v));
+	EXPECT(matches_all<std::uint32_t>(inputs_v));
+	EXPECT(matches_all<std::int64_t>(inputs_v));
+	EXPECT(matches_all<std::uint64_t>(inputs_v));
+	EXPECT(matches_all<float>(inputs_v));
+	EXPECT(matches_all<double>(inputs_v));
+}
+
+TEST(parse_number_digit_counts) {
+	auto value = std::string{};
+	for (auto digit = 1; digit <= 20; ++digit) {
+		value += char('0' + (digit % 10));
+		EXPECT(matches_from_chars<std::int64_t>(value));
+		EXPECT(matches_from_chars<std::uint64_t>(value));
+		EXPECT(matches_from_chars<std::int64_t>("-" + value));
+	}
+}
+} // namespace
@@ -1,6 +1,9 @@
 #include <ktest/ktest.hpp>
 #include <parser.hpp>
 #include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace {
 using namespace cliq;
@@ -126,4 +129,263 @@ TEST(parser_command) {
 	EXPECT(cmd_flag == true);
 	EXPECT(cmd_arg == "cmd-arg");
 }
+
+TEST(parser_abbreviations) {
+	bool verbose{};
+	bool version_check{};
+	int count{};
+	auto const args = std::array{
+		Arg{verbose, "verbose"},
+		Arg{version_check, "version-check"},
+		Arg{count, "count"},
+	};
+
+	static constexpr auto unique_v = std::array{"--verb", "--co=42"};
+	auto parser = Parser{app_info_v, {}, unique_v};
+	EXPECT(!parser.parse(args).early_return());
+	EXPECT(verbose && !version_check && count == 42);
+
+	static constexpr auto ambiguous_v = std::array{"--ver"};
+	auto ambiguous = Parser{app_info_v, {}, ambiguous_v};
+	EXPECT(ambiguous.parse(args).get_parse_error() == ParseError::AmbiguousOption);
+}
+
+TEST(parser_suggestions) {
+	bool verbose{};
+	auto const cmd_args = std::array{Arg{verbose, "force"}};
+	auto const args = std::array{
+		Arg{verbose, "verbose"},
+		Arg{cmd_args, "remove"},
+	};
+
+	static constexpr auto option_v = std::array{"--vrebose"};
+	auto option_parser = Parser{app_info_v, {}, option_v};
+	auto const option_result = option_parser.parse(args);
+	EXPECT(option_result.get_parse_error() == ParseError::InvalidOption);
+	EXPECT(option_result.get_suggestion() == "verbose");
+
+	static constexpr auto command_v = std::array{"remve"};
+	auto command_parser = Parser{app_info_v, {}, command_v};
+	auto const command_result = command_parser.parse(args);
+	EXPECT(command_result.get_parse_error() == ParseError::InvalidCommand);
+	EXPECT(command_result.get_suggestion() == "remove");
+}
+
+TEST(parser_nested_commands) {
+	static constexpr auto cli_args = std::array{"-v", "cluster", "--zone=b", "node", "drain", "-f", "n1"};
+	bool verbose{};
+	std::string_view zone{};
+	bool force{};
+	std::string_view node{};
+	auto const drain_args = std::array{Arg{force, "f,force"}, Arg{node, ArgType::Required, "NODE"}};
+	auto const node_args = std::array{Arg{drain_args, "drain"}};
+	auto const cluster_args = std::array{Arg{zone, "zone"}, Arg{node_args, "node"}};
+	auto const args = std::array{Arg{verbose, "v,verbose"}, Arg{cluster_args, "cluster"}};
+
+	auto parser = Parser{app_info_v, {}, cli_args};
+	auto const result = parser.parse(args);
+	EXPECT(!result.early_return());
+	EXPECT(verbose && zone == "b" && force && node == "n1");
+	EXPECT(result.get_command_name() == "drain");
+	auto const path = result.get_command_path();
+	ASSERT(path.size() == 3);
+	EXPECT(path[0] == "cluster" && path[1] == "node" && path[2] == "drain");
+
+	static constexpr auto partial_v = std::array{"cluster", "node"};
+	auto partial = Parser{app_info_v, {}, partial_v};
+	auto const missing = partial.parse(args);
+	EXPECT(missing.get_parse_error() == ParseError::MissingArgument);
+	EXPECT(missing.get_diagnostic().command == "cluster node");
+	EXPECT(missing.get_diagnostic().input == "command");
+}
+
+TEST(parser_global_options) {
+	static constexpr auto cli_args = std::array{"cluster", "node", "-v", "--zone=b", "drain", "--dry"};
+	bool verbose{};
+	bool dry_run{};
+	std::string_view zone{};
+	auto const drain_args = std::array{Arg{dry_run, "dry-run"}};
+	auto const node_args = std::array{Arg{drain_args, "drain"}};
+	auto const cluster_args = std::array{Arg{zone, "zone"}.as_global(), Arg{node_args, "node"}};
+	auto const args = std::array{Arg{verbose, "v,verbose"}.as_global(), Arg{cluster_args, "cluster"}};
+
+	auto parser = Parser{app_info_v, {}, cli_args};
+	auto const result = parser.parse(args);
+	EXPECT(!result.early_return());
+	EXPECT(verbose && dry_run && zone == "b");
+
+	verbose = dry_run = false;
+	zone = {};
+	auto const tree = CommandTree{args, *std::pmr::get_default_resource()};
+	auto compiled = Parser{app_info_v, {}, cli_args};
+	EXPECT(!compiled.parse(tree).early_return());
+	EXPECT(verbose && dry_run && zone == "b");
+
+	// globals only apply to nested commands, not to parents.
+	static constexpr auto parent_v = std::array{"--zone=b", "cluster", "node", "drain"};
+	auto parent = Parser{app_info_v, {}, parent_v, ParseConfig{.print_errors = false}};
+	EXPECT(parent.parse(args).get_parse_error() == ParseError::InvalidOption);
+}
+
+TEST(parser_list_reserve) {
+	static constexpr auto cli_args = std::array{"-v", "a", "b", "c"};
+	bool verbose{};
+	auto files = std::vector<std::string_view>{};
+	auto const args = std::array{
+		Arg{verbose, "v"},
+		Arg{files, "files"},
+	};
+	auto parser = Parser{app_info_v, {}, cli_args};
+	auto const result = parser.parse(args);
+	EXPECT(!result.early_return());
+	EXPECT(verbose && files.size() == 3);
+	EXPECT(files.capacity() == 3);
+}
+
+TEST(parser_list_argv_span) {
+	static constexpr auto cli_args = std::array{"-v", "a", "b", "c"};
+	bool verbose{};
+	auto files = ArgvSpan{};
+	auto const args = std::array{
+		Arg{verbose, "v"},
+		Arg{files, "files"},
+	};
+	auto parser = Parser{app_info_v, {}, cli_args};
+	auto const result = parser.parse(args);
+	EXPECT(!result.early_return());
+	EXPECT(verbose && files.size() == 3);
+	EXPECT(files.data() == cli_args.data() + 1);
+
+	static constexpr auto interleaved_args = std::array{"a", "-v", "b"};
+	files = {};
+	auto interleaved = Parser{app_info_v, {}, interleaved_args};
+	EXPECT(interleaved.parse(args).get_return_code() != EXIT_SUCCESS);
+}
+
+TEST(parser_repeated_option) {
+	static constexpr auto cli_args = std::array{"-I", "a", "--include=b", "-vI=c", "file"};
+	bool verbose{};
+	auto includes = std::vector<std::string>{};
+	std::string_view file{};
+	auto const args = std::array{
+		flag(verbose, "v"),
+		option(includes, "I,include"),
+		positional(file, ArgType::Required, "file"),
+	};
+	auto parser = Parser{app_info_v, {}, cli_args};
+	EXPECT(!parser.parse(args).early_return());
+	EXPECT(verbose && file == "file");
+	EXPECT((includes == std::vector<std::string>{"a", "b", "c"}));
+}
+
+TEST(parser_list_numbers) {
+	static constexpr auto cli_args = std::array{"1", "-2", "3", "-v", "4", "--", "-5"};
+	bool verbose{};
+	auto values = std::vector<int>{};
+	auto const args = std::array{
+		Arg{verbose, "v"},
+		Arg{values, "values"},
+	};
+	auto parser = Parser{app_info_v, {}, cli_args};
+	auto const result = parser.parse(args);
+	EXPECT(!result.early_return());
+	auto const expected = std::vector{1, -2, 3, 4, -5};
+	EXPECT(verbose && values == expected);
+
+	static constexpr auto invalid_args = std::array{"1", "2", "x", "4"};
+	values.clear();
+	auto invalid = Parser{app_info_v, {}, invalid_args};
+	EXPECT(invalid.parse(args).get_return_code() != EXIT_SUCCESS);
+	EXPECT(values.size() == 2 && values.back() == 2);
+}
+
+TEST(parser_list_threaded) {
+	auto storage = std::vector<std::string>{};
+	for (auto i = 0; i < 40'000; ++i) { storage.push_back(std::to_string(i)); }
+	auto cli_args = std::vector<char const*>{};
+	for (auto const& str : storage) { cli_args.push_back(str.c_str()); }
+	auto values = std::vector<int>{};
+	auto const args = std::array{Arg{values, "values"}};
+	auto const config = ParseConfig{.print_errors = false, .batch_threads = 4};
+
+	auto parser = Parser{app_info_v, {}, cli_args, config};
+	EXPECT(!parser.parse(args).early_return());
+	ASSERT(values.size() == storage.size());
+	EXPECT(values[0] == 0 && values[12'345] == 12'345 && values.back() == 39'999);
+
+	// the first invalid value in argv order is reported, however chunks were scheduled.
+	storage[30'000] = "x";
+	storage[20'000] = "y";
+	cli_args[30'000] = storage[30'000].c_str();
+	cli_args[20'000] = storage[20'000].c_str();
+	values.clear();
+	auto invalid = Parser{app_info_v, {}, cli_args, config};
+	auto const result = invalid.parse(args);
+	EXPECT(result.get_parse_error() == ParseError::InvalidArgument);
+	EXPECT(result.get_diagnostic().index == 20'000);
+	EXPECT(result.get_diagnostic().value == "y");
+	EXPECT(values.size() == 20'000);
+}
+
+/// \brief Converts like int, but throws on an invalid value (as a custom conversion might).
+struct Checked {
+	int value{};
+
+	friend auto cliq_assign(Checked& out, std::string_view const value) -> bool {
+		if (!parse_number(value, out.value)) { throw std::invalid_argument{std::string{value}}; }
+		return true;
+	}
+};
+
+TEST(parser_list_threaded_throws) {
+	auto storage = std::vector<std::string>{};
+	for (auto i = 0; i < 40'000; ++i) { storage.push_back(std::to_string(i)); }
+	storage[30'000] = "x";
+	storage[20'000] = "y";
+	auto cli_args = std::vector<char const*>{};
+	for (auto const& str : storage) { cli_args.push_back(str.c_str()); }
+	auto values = std::vector<Checked>{};
+	auto const args = std::array{Arg{values, "values"}};
+	auto parser = Parser{app_info_v, {}, cli_args, ParseConfig{.print_errors = false, .batch_threads = 4}};
+
+	// the exception a serial parse would throw is rethrown on the calling thread, once every worker has joined.
+	auto thrown = std::string{};
+	try {
+		[[maybe_unused]] auto const result = parser.parse(args);
+	} catch (std::invalid_argument const& e) { thrown = e.what(); }
+	EXPECT(thrown == "y");
+}
+
+TEST(parser_stream_list) {
+	static constexpr auto cli_args = std::array{"-v", "a", "-v", "--", "--", "b"};
+	bool verbose{};
+	auto words = Stream<std::string_view>{};
+	auto const args = std::array{Arg{verbose, "v"}, stream_list(words, "words")};
+	auto parser = Parser{app_info_v, {}, cli_args};
+	EXPECT(!parser.parse(args).early_return());
+	EXPECT(verbose);
+	auto out = std::vector<std::string_view>{};
+	for (auto const word : words) { out.push_back(word); }
+	EXPECT((out == std::vector<std::string_view>{"a", "-v", "--", "b"}));
+	EXPECT(!words.has_error());
+
+	static constexpr auto separated_v = std::array{"a", "--", "b", "--", "c"};
+	auto separated = Stream<std::string_view>{};
+	auto const separated_args = std::array{stream_list(separated, "words")};
+	auto separated_parser = Parser{app_info_v, {}, separated_v};
+	EXPECT(!separated_parser.parse(separated_args).early_return());
+	out.clear();
+	for (auto const word : separated) { out.push_back(word); }
+	EXPECT((out == std::vector<std::string_view>{"a", "b", "--", "c"}));
+
+	static constexpr auto numbers_v = std::array{"1", "-2", "x", "4"};
+	auto numbers = Stream<int>{};
+	auto const number_args = std::array{stream_list(numbers, "numbers")};
+	auto number_parser = Parser{app_info_v, {}, numbers_v};
+	EXPECT(!number_parser.parse(number_args).early_return());
+	auto sum = 0;
+	for (auto const number : numbers) { sum += number; }
+	EXPECT(sum == -1);
+	EXPECT(numbers.has_error() && numbers.get_error_input() == "x");
+}
 } // namespace
@@ -0,0 +1,70 @@
+#include <cliq/parse.hpp>
+#include <ktest/ktest.hpp>
+#include <temp_file.hpp>
+#include <array>
+
+namespace {
+using namespace cliq;
+using cliq::test::TempFile;
+
+constexpr auto app_info_v = AppInfo{};
+
+TEST(response_file_expand) {
+	auto const file = TempFile{"cliq_test_response_file.txt", "-c 42\n'a b'  c\\ d\n\te \"\"\n"};
+	auto count = 0;
+	auto verbose = false;
+	auto inputs = std::vector<std::string_view>{};
+	auto const args = std::array{
+		option(count, "c,count"),
+		flag(verbose, "v,verbose"),
+		list(inputs, "inputs"),
+	};
+
+	auto const arg = "@" + file.path_str;
+	auto const argv = std::array{"app", "first", arg.c_str(), "-v", "last"};
+	auto const result = parse(app_info_v, args, int(argv.size()), argv.data(), ParseConfig{.response_files = true});
+	EXPECT(!result.early_return());
+	EXPECT(count == 42 && verbose);
+	EXPECT((inputs == std::vector<std::string_view>{"first", "a b", "c d", "e", "", "last"}));
+}
+
+TEST(response_file_stream) {
+	auto const file = TempFile{"cliq_test_response_stream.txt", "2 3\n-4\n"};
+	auto values = Stream<int>{};
+	auto const args = std::array{stream_list(values, "values")};
+
+	auto const arg = "@" + file.path_str;
+	auto const argv = std::array{"app", "1", arg.c_str(), "5", "@cliq-does-not-exist"};
+	auto const result = parse(app_info_v, args, int(argv.size()), argv.data(), ParseConfig{.response_files = true});
+	EXPECT(!result.early_return());
+	auto out = std::vector<int>{};
+	for (auto const value : values) { out.push_back(value); }
+	EXPECT((out == std::vector{1, 2, 3, -4, 5}));
+	EXPECT(values.has_error() && values.get_error_input() == "@cliq-does-not-exist");
+}
+
+TEST(response_file_disabled) {
+	auto inputs = std::vector<std::string_view>{};
+	auto const args = std::array{list(inputs, "inputs")};
+	static constexpr auto argv = std::array{"app", "@does-not-exist"};
+	auto const result = parse(app_info_v, args, int(argv.size()), argv.data());
+	EXPECT(!result.early_return());
+	EXPECT(inputs.size() == 1 && inputs.front() == "@does-not-exist");
+}
+
+TEST(response_file_errors) {
+	auto inputs = std::vector<std::string_view>{};
+	auto const args = std::array{list(inputs, "inputs")};
+	auto const config = ParseConfig{.response_files = true};
+
+	static constexpr auto missing_v = std::array{"app", "@does-not-exist"};
+	auto result = parse(app_info_v, args, int(missing_v.size()), missing_v.data(), config);
+	EXPECT(result.get_parse_error() == ParseError::InvalidArgument);
+
+	inputs.clear();
+	static constexpr auto forced_v = std::array{"app", "--", "@does-not-exist", "-x"};
+	result = parse(app_info_v, args, int(forced_v.size()), forced_v.data(), config);
+	EXPECT(!result.early_return());
+	EXPECT((inputs == std::vector<std::string_view>{"@does-not-exist", "-x"}));
+}
+} // namespace
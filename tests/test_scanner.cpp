@@ -1,5 +1,6 @@
 #include <scanner.hpp>
 #include <array>
+#include <string>
 
 namespace {
 using namespace cliq;
@@ -101,4 +102,41 @@ static_assert([] {
 
 	return !scanner.next();
 }());
+static_assert([] {
+	auto line = std::string{"-a 'b c' --d=\"e f\""};
+	auto scanner = Scanner{Tokenizer{line}};
+
+	if (!scanner.next()) { return false; }
+	if (scanner.get_token_type() != TokenType::Option) { return false; }
+	if (scanner.get_key() != "a") { return false; }
+
+	if (!scanner.next()) { return false; }
+	if (scanner.get_token_type() != TokenType::Argument) { return false; }
+	if (scanner.get_value() != "b c") { return false; }
+
+	if (!scanner.next()) { return false; }
+	if (scanner.get_option_type() != OptionType::Word) { return false; }
+	if (scanner.get_key() != "d") { return false; }
+	if (scanner.get_value() != "e f") { return false; }
+
+	return !scanner.next() && scanner.get_error() == ScanError::None;
+}());
+
+static_assert([] {
+	constexpr auto args = std::array{"-a", "--", "-b", "--c"};
+	auto scanner = Scanner{args};
+
+	if (!scanner.next() || scanner.get_token_type() != TokenType::Option) { return false; }
+	if (!scanner.next() || scanner.get_token_type() != TokenType::ForceArgs) { return false; }
+
+	if (!scanner.next()) { return false; }
+	if (scanner.get_token_type() != TokenType::Argument) { return false; }
+	if (scanner.get_value() != "-b") { return false; }
+
+	if (!scanner.next()) { return false; }
+	if (scanner.get_token_type() != TokenType::Argument) { return false; }
+	if (scanner.get_value() != "--c") { return false; }
+
+	return !scanner.next();
+}());
 } // namespace
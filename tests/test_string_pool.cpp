@@ -0,0 +1,40 @@
+#include <cliq/parse.hpp>
+#include <ktest/ktest.hpp>
+#include <array>
+#include <string>
+
+namespace {
+using namespace cliq;
+
+constexpr auto app_info_v = AppInfo{};
+
+TEST(string_pool_intern) {
+	auto pool = StringPool{};
+	auto text = std::string{"foo"};
+	auto const foo = pool.intern(text);
+	text = "bar";
+	EXPECT(foo == "foo");
+	EXPECT(pool.intern("foo").data() == foo.data());
+	EXPECT(pool.intern(text) == "bar");
+	EXPECT(pool.intern("").empty());
+	EXPECT(pool.size() == 3);
+}
+
+TEST(string_pool_interned_strings) {
+	auto pool = StringPool{};
+	auto tags = InternedStrings{pool};
+	auto files = InternedStrings{pool};
+	auto const args = std::array{option(tags, "t,tag"), list(files, "files")};
+	static constexpr auto argv = std::array{"app", "-t", "foo", "a", "--tag=bar", "b", "-t=foo", "foo"};
+	auto const result = parse(app_info_v, args, int(argv.size()), argv.data());
+	EXPECT(!result.early_return());
+	auto const tag_values = tags.get_values();
+	ASSERT(tag_values.size() == 3);
+	EXPECT(tag_values[0] == "foo" && tag_values[1] == "bar" && tag_values[2] == "foo");
+	EXPECT(tag_values[0].data() == tag_values[2].data());
+	auto const file_values = files.get_values();
+	ASSERT(file_values.size() == 3);
+	EXPECT(file_values[2].data() == tag_values[0].data());
+	EXPECT(pool.size() == 4);
+}
+} // namespace
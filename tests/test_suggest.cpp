@@ -0,0 +1,33 @@
+#include <ktest/ktest.hpp>
+#include <suggest.hpp>
+#include <array>
+
+namespace {
+using namespace cliq;
+
+TEST(suggest_edit_distance) {
+	EXPECT(edit_distance("verbose", "verbose", 2) == 0);
+	EXPECT(edit_distance("verbse", "verbose", 2) == 1);
+	EXPECT(edit_distance("vebrose", "verbose", 2) == 1);
+	EXPECT(edit_distance("vrbse", "verbose", 2) == 2);
+	EXPECT(edit_distance("count", "verbose", 2) == 3);
+	EXPECT(edit_distance("", "ab", 2) == 2);
+	EXPECT(edit_distance("", "abc", 2) == 3);
+}
+
+TEST(suggest_nearest) {
+	static constexpr auto words = std::array<std::string_view, 4>{"verbose", "version", "count", "cd"};
+	auto const nearest = [](std::string_view const word) {
+		auto ret = NearestWord{word};
+		for (auto const candidate : words) { ret.add(candidate); }
+		return ret.get();
+	};
+
+	EXPECT(nearest("verbos") == "verbose");
+	EXPECT(nearest("versoin") == "version");
+	EXPECT(nearest("cuont") == "count");
+	EXPECT(nearest("cx") == "cd");
+	EXPECT(nearest("xyz").empty());
+	EXPECT(nearest("").empty());
+}
+} // namespace
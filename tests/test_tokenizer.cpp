@@ -0,0 +1,46 @@
+#include <tokenizer.hpp>
+#include <array>
+#include <string>
+
+namespace {
+using namespace cliq;
+
+template <std::size_t N>
+constexpr auto tokenizes_to(std::string_view const input, std::array<std::string_view, N> const& expected) -> bool {
+	auto buffer = std::string{input};
+	auto tokenizer = Tokenizer{buffer};
+	auto word = std::string_view{};
+	for (auto const& e : expected) {
+		if (!tokenizer.next(word) || word != e) { return false; }
+	}
+	return !tokenizer.next(word) && !tokenizer.is_malformed();
+}
+
+static_assert(tokenizes_to<0>("", {}));
+static_assert(tokenizes_to<0>(" \t\n ", {}));
+static_assert(tokenizes_to<3>("  -a foo\t--bar=42 ", {"-a", "foo", "--bar=42"}));
+static_assert(tokenizes_to<2>("'hello world' x", {"hello world", "x"}));
+static_assert(tokenizes_to<1>(R"("say \"hi\" \\ \n")", {R"(say "hi" \ \n)"}));
+static_assert(tokenizes_to<1>(R"('a\b"c')", {R"(a\b"c)"}));
+static_assert(tokenizes_to<2>(R"(a\ b c\\)", {"a b", R"(c\)"}));
+static_assert(tokenizes_to<1>(R"(--name="foo bar"baz)", {"--name=foo barbaz"}));
+static_assert(tokenizes_to<2>(R"("" x)", {"", "x"}));
+static_assert(tokenizes_to<1>(R"(trailing\)", {R"(trailing\)"}));
+
+static_assert([] {
+	auto buffer = std::string{"ok 'unterminated"};
+	auto tokenizer = Tokenizer{buffer};
+	auto word = std::string_view{};
+	if (!tokenizer.next(word) || word != "ok") { return false; }
+	return !tokenizer.next(word) && tokenizer.is_malformed();
+}());
+
+// words without quotes or escapes are views into the original buffer.
+static_assert([] {
+	auto buffer = std::string{"abc 'd e'"};
+	auto tokenizer = Tokenizer{buffer};
+	auto word = std::string_view{};
+	if (!tokenizer.next(word) || word.data() != buffer.data()) { return false; }
+	return tokenizer.next(word) && word.data() == buffer.data() + 4;
+}());
+} // namespace
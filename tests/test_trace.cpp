@@ -0,0 +1,62 @@
+#include <cliq/trace.hpp>
+#include <ktest/ktest.hpp>
+#include <parser.hpp>
+#include <array>
+
+namespace {
+using namespace cliq;
+
+constexpr auto app_info_v = AppInfo{};
+
+TEST(trace_json_line) {
+	bool verbose{};
+	auto const arg = Arg{verbose, "v,verbose"};
+	auto const event = TraceEvent{
+		.index = 2,
+		.input = "--verbose=\"x\"",
+		.token_type = TokenType::Option,
+		.option_type = OptionType::Word,
+		.option = &std::get<ParamOption>(arg.get_param()),
+		.outcome = TraceOutcome::Failed,
+		.elapsed = std::chrono::nanoseconds{42},
+	};
+	auto line = std::pmr::string{};
+	append_json_line(event, line);
+	EXPECT(line == R"({"index":2,"count":1,"input":"--verbose=\"x\"","token_type":"option","option_type":"word",)"
+				   R"("param":{"kind":"option","name":"verbose"},"outcome":"failed","elapsed_ns":42})"
+				   "\n");
+}
+
+TEST(trace_parse) {
+	static constexpr auto cli_args = std::array{"-v", "cmd", "--count", "3", "--", "a"};
+	bool verbose{};
+	int count{};
+	std::string_view name{};
+	auto const cmd_args = std::array{Arg{count, "count"}, Arg{name, ArgType::Required, "NAME"}};
+	auto const args = std::array{Arg{verbose, "v,verbose"}, Arg{cmd_args, "cmd"}};
+
+	auto tracer = JsonLinesTracer{};
+	auto parser = Parser{app_info_v, {}, cli_args, ParseConfig{.tracer = &tracer}};
+	EXPECT(!parser.parse(args).early_return());
+	if constexpr (!trace_enabled_v) {
+		EXPECT(tracer.get_lines().empty());
+		return;
+	}
+
+	auto lines = tracer.get_lines();
+	auto const next_line = [&lines] {
+		auto const eol = lines.find('\n');
+		auto const ret = lines.substr(0, eol);
+		lines = lines.substr(eol + 1);
+		return ret;
+	};
+	EXPECT(next_line().contains(R"("param":{"kind":"option","name":"verbose"},"outcome":"assigned")"));
+	EXPECT(next_line().contains(R"("param":{"kind":"command","name":"cmd"},"outcome":"selected_command")"));
+	auto const count_line = next_line();
+	EXPECT(count_line.starts_with(R"({"index":2,"count":2,"input":"--count")"));
+	EXPECT(count_line.contains(R"("outcome":"assigned")"));
+	EXPECT(next_line().contains(R"("token_type":"force_args","option_type":"none","outcome":"none")"));
+	EXPECT(next_line().contains(R"("param":{"kind":"positional","name":"NAME"},"outcome":"assigned")"));
+	EXPECT(lines.empty());
+}
+} // namespace
@@ -0,0 +1,128 @@
+#include <cliq/arg.hpp>
+#include <ktest/ktest.hpp>
+#include <parser.hpp>
+#include <array>
+#include <chrono>
+
+namespace example {
+enum class Level : std::int8_t { Low, Medium, High };
+
+struct Endpoint {
+	std::string_view host{};
+	std::uint16_t port{};
+};
+
+enum class Mode : std::int8_t { Fast, Safe };
+
+// ignored: Mode is bound by name, through EnumNames.
+inline auto cliq_assign(Mode& /*out*/, std::string_view /*value*/) -> bool { return false; }
+
+inline auto cliq_assign(Endpoint& out, std::string_view const value) -> bool {
+	auto const colon = value.rfind(':');
+	if (colon == std::string_view::npos || colon == 0) { return false; }
+	out.host = value.substr(0, colon);
+	return cliq::parse_number(value.substr(colon + 1), out.port);
+}
+} // namespace example
+
+template <>
+struct cliq::EnumNames<example::Level> {
+	static constexpr auto entries = std::array{
+		EnumName{example::Level::Low, "low"},
+		EnumName{example::Level::Medium, "medium"},
+		EnumName{example::Level::High, "high"},
+	};
+};
+
+template <>
+struct cliq::EnumNames<example::Mode> {
+	static constexpr auto entries = std::array{
+		EnumName{example::Mode::Fast, "fast"},
+		EnumName{example::Mode::Safe, "safe"},
+	};
+};
+
+namespace {
+using namespace cliq;
+using namespace std::chrono_literals;
+using example::Endpoint;
+using example::Level;
+using example::Mode;
+
+static_assert(ParamT<Level> && ParamT<std::chrono::milliseconds> && ParamT<ByteSize> && ParamT<Endpoint>);
+static_assert(!ParamT<std::chrono::system_clock::time_point>);
+static_assert(NamedEnumT<Mode> && !CustomT<Mode>);
+
+TEST(value_types_enum) {
+	auto level = Level::Low;
+	EXPECT(assign_to(level, "high") && level == Level::High);
+	EXPECT(!assign_to(level, "High") && level == Level::High);
+	EXPECT(as_string(Level::Medium) == "medium");
+
+	auto mode = Mode::Fast;
+	EXPECT(assign_to(mode, "safe") && mode == Mode::Safe);
+}
+
+TEST(value_types_duration) {
+	auto ms = std::chrono::milliseconds{};
+	EXPECT(assign_to(ms, "250") && ms == 250ms);
+	EXPECT(assign_to(ms, "2s") && ms == 2s);
+	EXPECT(assign_to(ms, "3m") && ms == 3min);
+	EXPECT(assign_to(ms, "-1h") && ms == -1h);
+	EXPECT(assign_to(ms, "2000us") && ms == 2ms);
+	EXPECT(!assign_to(ms, "1500us"));
+	EXPECT(assign_to(ms, "1.5s") && ms == 1500ms);
+	EXPECT(assign_to(ms, "-0.25s") && ms == -250ms);
+	EXPECT(assign_to(ms, "1.50000s") && ms == 1500ms);
+	EXPECT(!assign_to(ms, "1.0005s"));
+	EXPECT(!assign_to(ms, "1.s"));
+	EXPECT(!assign_to(ms, "5 s"));
+	EXPECT(!assign_to(ms, "5parsecs"));
+	EXPECT(as_string(250ms) == "250ms");
+
+	auto seconds = std::chrono::duration<std::int32_t>{};
+	EXPECT(!assign_to(seconds, "1000000000h"));
+	EXPECT(assign_to(seconds, "0.5min") && seconds.count() == 30);
+	EXPECT(!assign_to(seconds, "0.01min"));
+
+	auto fractional = std::chrono::duration<double>{};
+	EXPECT(assign_to(fractional, "1.5s") && fractional.count() == 1.5);
+	EXPECT(assign_to(fractional, "500ms") && fractional.count() == 0.5);
+}
+
+TEST(value_types_byte_size) {
+	auto size = ByteSize{};
+	EXPECT(assign_to(size, "64MiB") && size.bytes == 64ull << 20);
+	EXPECT(assign_to(size, "64M") && size.bytes == 64ull << 20);
+	EXPECT(assign_to(size, "3kB") && size.bytes == 3000);
+	EXPECT(assign_to(size, "1.5KiB") && size.bytes == 1536);
+	EXPECT(assign_to(size, "42") && size.bytes == 42);
+	EXPECT(!assign_to(size, "16EiB"));
+	EXPECT(!assign_to(size, "20000000TiB"));
+	EXPECT(!assign_to(size, "MiB"));
+	EXPECT(as_string(ByteSize{64ull << 20}) == "64MiB");
+	EXPECT(as_string(ByteSize{1000}) == "1000B");
+}
+
+TEST(value_types_parse) {
+	static constexpr auto cli_args = std::array{"--level=medium", "-t", "30s", "--cache", "1GiB", "localhost:8080", "a:1", "b:2"};
+	auto level = Level::Low;
+	auto timeout = std::chrono::seconds{};
+	auto cache = ByteSize{};
+	auto endpoint = Endpoint{};
+	auto peers = std::vector<Endpoint>{};
+	auto const args = std::array{
+		option(level, "level"),
+		option(timeout, "t,timeout"),
+		option(cache, "cache"),
+		positional(endpoint, ArgType::Required, "endpoint"),
+		list(peers, "peers"),
+	};
+	auto parser = Parser{AppInfo{}, {}, cli_args};
+	auto const result = parser.parse(args);
+	EXPECT(!result.early_return());
+	EXPECT(level == Level::Medium && timeout == 30s && cache.bytes == 1ull << 30);
+	EXPECT(endpoint.host == "localhost" && endpoint.port == 8080);
+	EXPECT(peers.size() == 2 && peers[1].host == "b" && peers[1].port == 2);
+}
+} // namespace